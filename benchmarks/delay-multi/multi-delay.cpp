@@ -0,0 +1,46 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "delay.h"
+
+#include <vector>
+
+template<typename Sample, bool interleaved>
+struct MultiDelayImpl {
+	static constexpr int blockLength = 1000;
+	int channels;
+	std::vector<Sample> delays, frame;
+	signalsmith::delay::MultiDelay<Sample, signalsmith::delay::InterpolatorLinear, interleaved> multiDelay;
+
+	MultiDelayImpl(int channels) : channels(channels), delays(channels), frame(channels), multiDelay(channels, 4096) {
+		// Different (mutually prime-ish) lengths for each channel, like an FDN
+		for (int c = 0; c < channels; ++c) {
+			delays[c] = 1000 + 37.3*c;
+			frame[c] = c;
+		}
+	}
+
+	inline void run() {
+		for (int i = 0; i < blockLength; ++i) {
+			multiDelay.readMulti(delays, frame);
+			multiDelay.write(frame);
+		}
+	}
+};
+
+template<typename Sample>
+void benchmarkMultiDelay(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "channels");
+	benchmark.add<MultiDelayImpl<Sample, false>>("channel-major");
+	benchmark.add<MultiDelayImpl<Sample, true>>("interleaved");
+
+	for (int channels : {4, 16, 64}) {
+		test.log("channels = ", channels);
+		benchmark.run(channels, channels*MultiDelayImpl<Sample, true>::blockLength);
+	}
+}
+
+TEST("Multi-channel delay layouts") {
+	benchmarkMultiDelay<float>(test, "delay_multi_layout_float");
+	benchmarkMultiDelay<double>(test, "delay_multi_layout_double");
+}
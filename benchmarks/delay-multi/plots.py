@@ -0,0 +1,15 @@
+import article
+
+def barPlot(name):
+	columns, data = article.readCsv("%s.csv"%name)
+
+	figure, axes = article.medium();
+	xticks = range(len(data[0]))
+	width = 0.8/(len(columns) - 1)
+	for i in range(1, len(columns)):
+		axes.bar([x + (i - 1)*width for x in xticks], 1/data[i], width=width, label=columns[i]);
+	axes.set(xlabel="channels", ylabel="speed (higher is better)", xticks=[x + 0.4 - width*0.5 for x in xticks], xticklabels=[str(int(x)) for x in data[0]]);
+	figure.save("%s.svg"%name)
+
+barPlot("delay_multi_layout_float")
+barPlot("delay_multi_layout_double")
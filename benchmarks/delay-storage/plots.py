@@ -0,0 +1,16 @@
+import article
+
+def plainPlot(name):
+	columns, data = article.readCsv("%s.csv"%name)
+
+	figure, axes = article.medium();
+	xticks = range(len(data[0]));
+	xlabels = ["%ik"%(int(x)/1024) if x < 1024*1024 else "%iM"%(int(x)/1024/1024) for x in data[0]]
+
+	for i in range(1, len(columns)):
+		axes.plot(xticks, 1/data[i], label=columns[i]);
+	axes.set(xlabel="capacity (samples)", ylabel="speed (higher is better)", xticks=xticks, xticklabels=xlabels);
+	figure.save("%s.svg"%name)
+
+plainPlot("delay_storage_float")
+plainPlot("delay_storage_double")
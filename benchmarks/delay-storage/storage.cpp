@@ -0,0 +1,53 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "delay.h"
+
+#include <vector>
+#include <random>
+
+template<typename Sample, template<typename> class Storage>
+struct StorageImpl {
+	static constexpr int blockLength = 1000;
+	signalsmith::delay::Delay<Sample, signalsmith::delay::InterpolatorCubic, Storage> delay;
+	std::vector<Sample> input, output, delays;
+
+	StorageImpl(int capacity) : delay(capacity), input(blockLength), output(blockLength), delays(blockLength) {
+		std::default_random_engine engine(capacity);
+		std::uniform_real_distribution<Sample> unit(0, 1);
+		for (int i = 0; i < blockLength; ++i) {
+			input[i] = unit(engine)*2 - 1;
+			// Read from anywhere in the buffer, so the memory footprint matters
+			delays[i] = unit(engine)*(capacity - 4);
+		}
+		// Fill it up
+		for (int i = 0; i < capacity; ++i) delay.write(input[i%blockLength]);
+	}
+
+	inline void run() {
+		for (int i = 0; i < blockLength; ++i) {
+			output[i] = delay.write(input[i]).read(delays[i]);
+		}
+	}
+};
+
+template<typename Sample>
+void benchmarkStorage(Test &test, std::string name) {
+	using namespace signalsmith::delay;
+	Benchmark<int> benchmark(name, "capacity");
+	benchmark.add<StorageImpl<Sample, StorageNative>>("native");
+	benchmark.add<StorageImpl<Sample, StorageInt24>>("int24");
+	benchmark.add<StorageImpl<Sample, StorageInt16>>("int16");
+	benchmark.add<StorageImpl<Sample, StorageFloat16>>("float16");
+
+	test.log("bytes/sample: native = ", sizeof(typename StorageNative<Sample>::Stored), ", int24 = ", sizeof(typename StorageInt24<Sample>::Stored), ", int16 = ", sizeof(typename StorageInt16<Sample>::Stored), ", float16 = ", sizeof(typename StorageFloat16<Sample>::Stored));
+	for (int capacity = 1024; capacity <= (1<<24); capacity *= 4) {
+		test.log("capacity = ", capacity);
+		benchmark.run(capacity, StorageImpl<Sample, StorageNative>::blockLength);
+	}
+}
+
+TEST("Delay storage formats") {
+	benchmarkStorage<float>(test, "delay_storage_float");
+	benchmarkStorage<double>(test, "delay_storage_double");
+}
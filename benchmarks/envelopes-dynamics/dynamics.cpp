@@ -0,0 +1,77 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "envelopes.h"
+
+#include <cmath>
+#include <vector>
+
+static constexpr int dynamicsInputLength = 65536;
+static constexpr int dynamicsChannels = 2;
+
+template<typename Sample>
+struct DynamicsInput {
+	std::vector<std::vector<Sample>> input;
+	std::vector<Sample> gain;
+	DynamicsInput() : input(dynamicsChannels, std::vector<Sample>(dynamicsInputLength)), gain(dynamicsInputLength) {
+		for (int c = 0; c < dynamicsChannels; ++c) {
+			for (int i = 0; i < dynamicsInputLength; ++i) {
+				// Peaks up to +6dB, with quieter sections
+				Sample amp = ((i/4096)%2) ? 2 : 0.25;
+				input[c][i] = amp*Sample(((i + c*337)%1009)*7919%1009)/1009;
+			}
+		}
+	}
+};
+
+// `PeakHold`, `PeakDecayLinear` and `BoxStackFilter`, combined by hand
+template<typename Sample>
+struct DynamicsComposed : public DynamicsInput<Sample> {
+	signalsmith::envelopes::PeakHold<Sample> hold;
+	signalsmith::envelopes::PeakDecayLinear<Sample> release;
+	signalsmith::envelopes::BoxStackFilter<Sample> smoother;
+	DynamicsComposed(int lookahead) : hold(lookahead + 1), release(lookahead*8), smoother(lookahead + 1, 3) {
+		hold.reset(0);
+		release.reset(0);
+		smoother.reset(0);
+	}
+
+	inline void run() {
+		for (int i = 0; i < dynamicsInputLength; ++i) {
+			Sample level = 0;
+			for (int c = 0; c < dynamicsChannels; ++c) level = std::max(level, std::abs(this->input[c][i]));
+			Sample reductionDb = std::max<Sample>(0, 20*std::log10(level + Sample(1e-30)) + 1);
+			Sample smoothed = smoother(release(hold(reductionDb)));
+			this->gain[i] = std::pow(Sample(10), -smoothed/20);
+		}
+	}
+};
+
+template<typename Sample>
+struct DynamicsFused : public DynamicsInput<Sample> {
+	signalsmith::envelopes::DynamicsDetector<Sample, dynamicsChannels> detector;
+	DynamicsFused(int lookahead) : detector(lookahead, 0, lookahead*8) {
+		detector.setCurve(-1, INFINITY);
+	}
+
+	inline void run() {
+		detector.process(this->input, this->gain, dynamicsInputLength);
+	}
+};
+
+template<typename Sample>
+void benchmarkDynamics(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "lookahead");
+	benchmark.add<DynamicsComposed<Sample>>("composed (per-sample)");
+	benchmark.add<DynamicsFused<Sample>>("DynamicsDetector");
+
+	for (int n = 16; n <= 4096; n *= 4) {
+		test.log("N = ", n);
+		benchmark.run(n, dynamicsInputLength);
+	}
+}
+
+TEST("Dynamics detector") {
+	benchmarkDynamics<float>(test, "envelopes_dynamics_float");
+	benchmarkDynamics<double>(test, "envelopes_dynamics_double");
+}
@@ -0,0 +1,16 @@
+import article
+
+def plainPlot(name, legend_loc="best"):
+	columns, data = article.readCsv("%s.csv"%name)
+
+	figure, axes = article.medium();
+	xlabels = [str(int(x)) for x in data[0]];
+	xticks = range(len(data[0]));
+
+	for i in range(1, len(columns)):
+		axes.plot(xticks, 1/data[i], label=columns[i]);
+	axes.set(xlabel="look-ahead (samples)", ylabel="speed (higher is better)", xticks=xticks, xticklabels=xlabels);
+	figure.save("%s.svg"%name, legend_loc=legend_loc)
+
+plainPlot("envelopes_dynamics_float")
+plainPlot("envelopes_dynamics_double")
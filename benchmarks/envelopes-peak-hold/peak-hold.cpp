@@ -12,7 +12,9 @@ struct PeakHoldImpl {
 	int inputSize;
 	std::vector<Sample> input, output;
 	PeakHold peakHold;
-	PeakHoldImpl(int size) : inputSize(size*1000), input(size*1000), output(size*1000), peakHold(size) {}
+	PeakHoldImpl(int size) : inputSize(size*1000), input(size*1000), output(size*1000), peakHold(size) {
+		for (int i = 0; i < inputSize; ++i) input[i] = Sample((i%1009)*7919%1009);
+	}
 
 	inline void run() {
 		for (int i = 0; i < inputSize; ++i) {
@@ -21,12 +23,23 @@ struct PeakHoldImpl {
 	}
 };
 
+template<typename Sample>
+struct PeakHoldBlock : public PeakHoldImpl<Sample, signalsmith::envelopes::PeakHold<Sample>> {
+	using PeakHoldImpl<Sample, signalsmith::envelopes::PeakHold<Sample>>::PeakHoldImpl;
+
+	inline void run() {
+		this->peakHold.process(this->input.data(), this->output.data(), this->inputSize);
+	}
+};
+
 template<typename Sample>
 struct PeakHoldKvrVadimDynamic {
 	int inputSize;
 	std::vector<Sample> input, output;
 	MovingMaxDynamic<Sample> movingMax;
-	PeakHoldKvrVadimDynamic(int size) : inputSize(size*1000), input(size*1000), output(size*1000), movingMax(size) {}
+	PeakHoldKvrVadimDynamic(int size) : inputSize(size*1000), input(size*1000), output(size*1000), movingMax(size) {
+		for (int i = 0; i < inputSize; ++i) input[i] = Sample((i%1009)*7919%1009);
+	}
 
 	inline void run() {
 		for (int i = 0; i < inputSize; ++i) {
@@ -40,6 +53,7 @@ void benchmarkPeakHold(Test &test, std::string name) {
 	Benchmark<int> benchmark(name, "size");
 
 	benchmark.add<PeakHoldImpl<Sample, signalsmith::envelopes::PeakHold<Sample>>>("current");
+	benchmark.add<PeakHoldBlock<Sample>>("current (block)");
 	benchmark.add<PeakHoldImpl<Sample, signalsmith_run_length_amortised::PeakHold<Sample>>>("run-length");
 	benchmark.add<PeakHoldImpl<Sample, signalsmith_constant_v1::PeakHold<Sample>>>("constant-v1");
 	benchmark.add<PeakHoldKvrVadimDynamic<Sample>>("Vadim");
@@ -56,7 +70,7 @@ void benchmarkPeakHold(Test &test, std::string name) {
 	}
 }
 
-TEST("Peak hold", peak_hold) {
+TEST("Peak hold") {
 	benchmarkPeakHold<double>(test, "envelopes_peak_hold_double");
 	benchmarkPeakHold<float>(test, "envelopes_peak_hold_float");
 	benchmarkPeakHold<int>(test, "envelopes_peak_hold_int");
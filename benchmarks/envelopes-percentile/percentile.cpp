@@ -0,0 +1,84 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "envelopes.h"
+
+#include <set>
+#include <vector>
+
+static constexpr int percentileInputLength = 65536;
+
+template<typename Sample>
+struct PercentileInput {
+	std::vector<Sample> input, output;
+	PercentileInput() : input(percentileInputLength), output(percentileInputLength) {
+		for (int i = 0; i < percentileInputLength; ++i) input[i] = Sample((i%1009)*7919%1009);
+	}
+};
+
+// Sliding median using a `std::multiset`, keeping an iterator to the middle
+template<typename Sample>
+struct MedianMultiset : public PercentileInput<Sample> {
+	int size;
+	std::vector<Sample> history;
+	int historyIndex = 0;
+	std::multiset<Sample> window;
+	typename std::multiset<Sample>::iterator middle;
+	MedianMultiset(int size) : size(size), history(size, 0), window(history.begin(), history.end()) {
+		middle = std::next(window.begin(), size/2);
+	}
+
+	inline void run() {
+		for (int i = 0; i < percentileInputLength; ++i) {
+			Sample v = this->input[i];
+			window.insert(v);
+			if (v < *middle) --middle;
+			Sample old = history[historyIndex];
+			if (old <= *middle) ++middle;
+			window.erase(window.lower_bound(old));
+			history[historyIndex] = v;
+			if (++historyIndex == size) historyIndex = 0;
+
+			this->output[i] = (size%2) ? *middle : (*middle + *std::prev(middle))*Sample(0.5);
+		}
+	}
+};
+
+template<typename Sample>
+struct MedianSliding : public PercentileInput<Sample> {
+	signalsmith::envelopes::SlidingPercentile<Sample> median;
+	MedianSliding(int size) : median(size) {}
+
+	inline void run() {
+		for (int i = 0; i < percentileInputLength; ++i) {
+			this->output[i] = median(this->input[i]);
+		}
+	}
+};
+
+template<typename Sample>
+struct MedianSlidingBlock : public MedianSliding<Sample> {
+	using MedianSliding<Sample>::MedianSliding;
+
+	inline void run() {
+		this->median.process(this->input.data(), this->output.data(), percentileInputLength);
+	}
+};
+
+template<typename Sample>
+void benchmarkMedian(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "size");
+	benchmark.add<MedianMultiset<Sample>>("std::multiset");
+	benchmark.add<MedianSliding<Sample>>("SlidingPercentile");
+	benchmark.add<MedianSlidingBlock<Sample>>("SlidingPercentile (block)");
+
+	for (int n = 16; n <= 65536; n *= 4) {
+		test.log("N = ", n);
+		benchmark.run(n, percentileInputLength);
+	}
+}
+
+TEST("Sliding median") {
+	benchmarkMedian<float>(test, "envelopes_percentile_float");
+	benchmarkMedian<double>(test, "envelopes_percentile_double");
+}
@@ -0,0 +1,94 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "filters.h"
+
+#include <vector>
+
+static constexpr int bankBlockLength = 256;
+
+template<typename Sample, int channels>
+struct SeparateBiquads {
+	std::vector<std::vector<Sample>> buffers;
+	std::vector<signalsmith::filters::BiquadStatic<Sample>> filters;
+
+	SeparateBiquads(int) : buffers(channels, std::vector<Sample>(bankBlockLength)), filters(channels) {
+		for (int c = 0; c < channels; ++c) {
+			filters[c].peakDb(0.01 + 0.001*c, 6);
+			for (int i = 0; i < bankBlockLength; ++i) buffers[c][i] = (i%37)*0.01;
+		}
+	}
+
+	inline void run() {
+		for (int c = 0; c < channels; ++c) {
+			filters[c].process(buffers[c].data(), bankBlockLength);
+		}
+	}
+};
+
+template<typename Sample, int channels>
+void designBank(signalsmith::filters::BiquadBank<Sample, channels, false> &bank) {
+	for (int c = 0; c < channels; ++c) {
+		bank.copyFrom(c, signalsmith::filters::BiquadStatic<Sample>().peakDb(0.01 + 0.001*c, 6));
+	}
+}
+template<typename Sample, int channels>
+void designBank(signalsmith::filters::BiquadBank<Sample, channels, true> &bank) {
+	bank.copyFrom(signalsmith::filters::BiquadStatic<Sample>().peakDb(0.01, 6));
+}
+
+template<typename Sample, int channels>
+struct BankChannels {
+	std::vector<std::vector<Sample>> buffers;
+	signalsmith::filters::BiquadBank<Sample, channels> bank;
+
+	BankChannels(int) : buffers(channels, std::vector<Sample>(bankBlockLength)) {
+		designBank(bank);
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < bankBlockLength; ++i) buffers[c][i] = (i%37)*0.01;
+		}
+	}
+
+	inline void run() {
+		bank.process(buffers, buffers, bankBlockLength);
+	}
+};
+
+template<typename Sample, int channels, bool shared=false>
+struct BankInterleaved {
+	std::vector<Sample> buffer;
+	signalsmith::filters::BiquadBank<Sample, channels, shared> bank;
+
+	BankInterleaved(int) : buffer(channels*bankBlockLength) {
+		designBank(bank);
+		for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = (i%37)*0.01;
+	}
+
+	inline void run() {
+		bank.processInterleaved(buffer.data(), bankBlockLength);
+	}
+};
+
+template<typename Sample, int channels>
+void addBankBenchmark(Test &test, Benchmark<int> &benchmark) {
+	benchmark.add<SeparateBiquads<Sample, channels>>("separate");
+	benchmark.add<BankChannels<Sample, channels>>("bank");
+	benchmark.add<BankInterleaved<Sample, channels>>("bank (interleaved)");
+	benchmark.add<BankInterleaved<Sample, channels, true>>("bank (interleaved, shared)");
+	test.log("channels = ", channels);
+	benchmark.run(channels, channels*bankBlockLength);
+}
+
+template<typename Sample>
+void benchmarkBank(Test &test, std::string name) {
+	// Each channel count is a separate type, so we use a separate benchmark (and CSV) for each
+	Benchmark<int> benchmark2(name + "_2", "channels"), benchmark8(name + "_8", "channels"), benchmark64(name + "_64", "channels");
+	addBankBenchmark<Sample, 2>(test, benchmark2);
+	addBankBenchmark<Sample, 8>(test, benchmark8);
+	addBankBenchmark<Sample, 64>(test, benchmark64);
+}
+
+TEST("Biquad bank") {
+	benchmarkBank<float>(test, "filters_biquad_bank_float");
+	benchmarkBank<double>(test, "filters_biquad_bank_double");
+}
@@ -0,0 +1,60 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "filters.h"
+
+#include <vector>
+
+template<typename Sample>
+struct CascadePerSample {
+	static constexpr int totalLength = 4096, blockLength = 256;
+	std::vector<Sample> buffer;
+	signalsmith::filters::BiquadCascade<Sample> filter;
+
+	CascadePerSample(int order) : buffer(totalLength) {
+		filter.butterworthLowpass(0.1, order);
+		for (int i = 0; i < totalLength; ++i) buffer[i] = (i%37)*0.01;
+	}
+
+	inline void run() {
+		for (int i = 0; i < totalLength; ++i) {
+			buffer[i] = filter(buffer[i]);
+		}
+	}
+};
+
+template<typename Sample>
+struct CascadeBlock : public CascadePerSample<Sample> {
+	using CascadePerSample<Sample>::CascadePerSample;
+
+	inline void run() {
+		for (int start = 0; start < this->totalLength; start += this->blockLength) {
+			this->filter.process(this->buffer.data() + start, this->blockLength);
+		}
+	}
+};
+
+template<typename Sample>
+struct CascadeParallel : public CascadeBlock<Sample> {
+	CascadeParallel(int order) : CascadeBlock<Sample>(order) {
+		this->filter.setParallel();
+	}
+};
+
+template<typename Sample>
+void benchmarkCascade(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "order");
+	benchmark.add<CascadePerSample<Sample>>("per-sample");
+	benchmark.add<CascadeBlock<Sample>>("block");
+	benchmark.add<CascadeParallel<Sample>>("parallel");
+
+	for (int order : {2, 4, 8, 16, 32}) {
+		test.log("order = ", order);
+		benchmark.run(order, CascadePerSample<Sample>::totalLength*order);
+	}
+}
+
+TEST("Biquad cascade") {
+	benchmarkCascade<float>(test, "filters_biquad_cascade_float");
+	benchmarkCascade<double>(test, "filters_biquad_cascade_double");
+}
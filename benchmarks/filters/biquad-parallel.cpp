@@ -0,0 +1,125 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+struct BiquadParallelData {
+	static constexpr int length = 1<<20, chunkLength = 1<<14;
+	std::vector<float> input, output;
+
+	BiquadParallelData() : input(length), output(length) {
+		for (int i = 0; i < length; ++i) input[i] = (i%37)*0.01;
+	}
+};
+
+// Threads are started once, and woken for each stage, so thread creation isn't part of the timing
+struct ThreadPool {
+	ThreadPool(int threadCount) : threadCount(threadCount) {
+		for (int t = 1; t < threadCount; ++t) {
+			threads.emplace_back([this, t]() {
+				workerLoop(t);
+			});
+		}
+	}
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		startCondition.notify_all();
+		for (auto &thread : threads) thread.join();
+	}
+
+	void parallelFor(int count, const std::function<void(int)> &task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			jobTask = &task;
+			jobCount = count;
+			busyWorkers = threadCount - 1;
+			++generation;
+		}
+		startCondition.notify_all();
+		for (int i = 0; i < count; i += threadCount) task(i);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		doneCondition.wait(lock, [&]() {return busyWorkers == 0;});
+	}
+private:
+	int threadCount;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable startCondition, doneCondition;
+	const std::function<void(int)> *jobTask = nullptr;
+	int jobCount = 0, busyWorkers = 0;
+	unsigned generation = 0;
+	bool stopping = false;
+
+	void workerLoop(int t) {
+		unsigned seenGeneration = 0;
+		while (true) {
+			const std::function<void(int)> *task;
+			int count;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				startCondition.wait(lock, [&]() {return stopping || generation != seenGeneration;});
+				if (stopping) return;
+				seenGeneration = generation;
+				task = jobTask;
+				count = jobCount;
+			}
+			for (int i = t; i < count; i += threadCount) (*task)(i);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (--busyWorkers == 0) doneCondition.notify_one();
+			}
+		}
+	}
+};
+
+struct BlockParallelThreads : public BiquadParallelData {
+	ThreadPool pool;
+	signalsmith::filters::BiquadBlockParallel<float> blockParallel{chunkLength};
+
+	BlockParallelThreads(int threadCount) : pool(threadCount) {
+		blockParallel.copyFrom(signalsmith::filters::BiquadStatic<float>().lowpass(0.01));
+	}
+
+	inline void run() {
+		blockParallel.process(input.data(), output.data(), length, [&](int count, std::function<void(int)> task) {
+			pool.parallelFor(count, task);
+		});
+	}
+};
+
+struct SerialBiquad : public BiquadParallelData {
+	signalsmith::filters::BiquadStatic<float> filter;
+
+	SerialBiquad(int) {
+		filter.lowpass(0.01);
+	}
+
+	inline void run() {
+		filter.process(input.data(), output.data(), length);
+	}
+};
+
+void benchmarkBlockParallel(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "threads");
+	benchmark.add<SerialBiquad>("serial");
+	benchmark.add<BlockParallelThreads>("block-parallel");
+
+	for (int threads : {1, 2, 4, 8, 16}) {
+		test.log("threads = ", threads);
+		benchmark.run(threads, BiquadParallelData::length);
+	}
+}
+
+TEST("Block-parallel biquad (thread scaling)") {
+	benchmarkBlockParallel(test, "filters_biquad_parallel");
+}
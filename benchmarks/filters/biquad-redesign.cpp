@@ -0,0 +1,73 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <array>
+
+using Design = signalsmith::filters::BiquadDesign;
+
+struct RedesignExact {
+	static constexpr int updates = 1000;
+	Design design;
+	std::vector<double> freqs;
+	std::vector<float> output; // so the designs aren't optimised out
+	signalsmith::filters::BiquadStatic<float> filter;
+
+	RedesignExact(int designIndex) : design(Design(designIndex)), freqs(updates), output(updates) {
+		for (int i = 0; i < updates; ++i) freqs[i] = 0.001 + 0.4*i/updates;
+	}
+
+	inline void run() {
+		for (int i = 0; i < updates; ++i) {
+			filter.peakDbQ(freqs[i], 6, 2, design);
+			output[i] = filter(1);
+		}
+	}
+};
+
+struct RedesignFast : public RedesignExact {
+	using RedesignExact::RedesignExact;
+
+	inline void run() {
+		for (int i = 0; i < updates; ++i) {
+			filter.peakDbQFast(freqs[i], 6, 2, design);
+			output[i] = filter(1);
+		}
+	}
+};
+
+struct RedesignBankFast : public RedesignExact {
+	static constexpr int channels = 8;
+	signalsmith::filters::BiquadBank<float, channels> bank;
+	std::array<float, channels> frame;
+
+	RedesignBankFast(int designIndex) : RedesignExact(designIndex) {
+		frame.fill(0);
+	}
+
+	inline void run() {
+		for (int i = 0; i < updates; i += channels) {
+			bank.peakDbQFast(freqs.data() + i, 6, 2, design);
+			bank(frame, output.data() + i);
+		}
+	}
+};
+
+void benchmarkRedesign(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "design");
+	benchmark.add<RedesignExact>("exact");
+	benchmark.add<RedesignFast>("fast");
+	benchmark.add<RedesignBankFast>("fast (bank)");
+
+	// bilinear, cookbook, oneSided
+	for (int design = 0; design < 3; ++design) {
+		test.log("design = ", design);
+		benchmark.run(design, RedesignExact::updates);
+	}
+}
+
+TEST("Biquad redesign (updates/second)") {
+	benchmarkRedesign(test, "filters_biquad_redesign");
+}
@@ -0,0 +1,56 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "filters.h"
+
+#include <vector>
+
+template<typename Sample>
+struct BiquadPerSample {
+	static constexpr int totalLength = 4096;
+	int blockLength;
+	std::vector<Sample> buffer;
+	signalsmith::filters::BiquadStatic<Sample> filter;
+
+	BiquadPerSample(int blockLength) : blockLength(blockLength), buffer(totalLength) {
+		filter.peakDb(0.1, 6);
+		for (int i = 0; i < totalLength; ++i) buffer[i] = (i%37)*0.01;
+	}
+
+	inline void run() {
+		for (int start = 0; start < totalLength; start += blockLength) {
+			Sample *block = buffer.data() + start;
+			for (int i = 0; i < blockLength; ++i) {
+				block[i] = filter(block[i]);
+			}
+		}
+	}
+};
+
+template<typename Sample>
+struct BiquadBlock : public BiquadPerSample<Sample> {
+	using BiquadPerSample<Sample>::BiquadPerSample;
+
+	inline void run() {
+		for (int start = 0; start < this->totalLength; start += this->blockLength) {
+			this->filter.process(this->buffer.data() + start, this->blockLength);
+		}
+	}
+};
+
+template<typename Sample>
+void benchmarkBiquad(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "blockLength");
+	benchmark.add<BiquadPerSample<Sample>>("per-sample");
+	benchmark.add<BiquadBlock<Sample>>("block");
+
+	for (int blockLength : {1, 4, 16, 64, 256, 1024}) {
+		test.log("blockLength = ", blockLength);
+		benchmark.run(blockLength, BiquadPerSample<Sample>::totalLength);
+	}
+}
+
+TEST("Biquad block processing") {
+	benchmarkBiquad<float>(test, "filters_biquad_block_float");
+	benchmarkBiquad<double>(test, "filters_biquad_block_double");
+}
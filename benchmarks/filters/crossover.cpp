@@ -0,0 +1,84 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "filters.h"
+
+#include <vector>
+
+static constexpr int crossoverChannels = 2, crossoverBlockLength = 256;
+
+static double crossoverSplit(int split, int bands) {
+	return 0.002*std::pow(100, (split + 1.0)/bands);
+}
+
+// Each band is filtered separately from the input: the highpass from every split below it, its own lowpass, and allpasses for the splits above
+struct CrossoverPerBand {
+	std::vector<std::vector<signalsmith::filters::BiquadCascade<float>>> filters;
+	std::vector<float> input;
+	std::vector<std::vector<std::vector<float>>> bands;
+
+	CrossoverPerBand(int bandCount) : filters(bandCount, std::vector<signalsmith::filters::BiquadCascade<float>>(crossoverChannels)), input(crossoverBlockLength), bands(bandCount, std::vector<std::vector<float>>(crossoverChannels, input)) {
+		for (int i = 0; i < crossoverBlockLength; ++i) input[i] = (i%37)*0.01;
+		for (int b = 0; b < bandCount; ++b) {
+			for (auto &cascade : filters[b]) {
+				int size = 0;
+				for (int s = 0; s < bandCount - 1; ++s) {
+					signalsmith::filters::BiquadCascade<float> split;
+					if (s < b) {
+						split.linkwitzRileyHighpass(crossoverSplit(s, bandCount), 4);
+					} else if (s == b) {
+						split.linkwitzRileyLowpass(crossoverSplit(s, bandCount), 4);
+					} else {
+						split.resize(1);
+						split[0].allpassQ(crossoverSplit(s, bandCount), 0.7071, signalsmith::filters::BiquadDesign::bilinear);
+					}
+					cascade.resize(size + split.size());
+					for (int i = 0; i < split.size(); ++i) cascade[size + i] = split[i];
+					size += split.size();
+				}
+			}
+		}
+	}
+
+	inline void run() {
+		for (size_t b = 0; b < bands.size(); ++b) {
+			for (int c = 0; c < crossoverChannels; ++c) {
+				filters[b][c].process(input.data(), bands[b][c].data(), crossoverBlockLength);
+			}
+		}
+	}
+};
+
+struct CrossoverTree {
+	signalsmith::filters::Crossover<float> crossover;
+	std::vector<std::vector<float>> input;
+	std::vector<std::vector<std::vector<float>>> bands;
+
+	CrossoverTree(int bandCount) : crossover(crossoverChannels), input(crossoverChannels, std::vector<float>(crossoverBlockLength)), bands(bandCount, input) {
+		for (auto &channel : input) {
+			for (int i = 0; i < crossoverBlockLength; ++i) channel[i] = (i%37)*0.01;
+		}
+		std::vector<double> splitFreqs(bandCount - 1);
+		for (int s = 0; s < bandCount - 1; ++s) splitFreqs[s] = crossoverSplit(s, bandCount);
+		crossover.linkwitzRiley(splitFreqs, bandCount - 1, 4);
+	}
+
+	inline void run() {
+		crossover.process(input, bands, crossoverBlockLength);
+	}
+};
+
+void benchmarkCrossover(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "bands");
+	benchmark.add<CrossoverPerBand>("per-band");
+	benchmark.add<CrossoverTree>("Crossover");
+
+	for (int bands : {2, 3, 4, 6, 8}) {
+		test.log("bands = ", bands);
+		benchmark.run(bands, crossoverBlockLength*crossoverChannels*bands);
+	}
+}
+
+TEST("Crossover") {
+	benchmarkCrossover(test, "filters_crossover");
+}
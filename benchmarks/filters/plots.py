@@ -0,0 +1,28 @@
+import article
+
+def barPlot(name, xlabel):
+	columns, data = article.readCsv("%s.csv"%name)
+
+	figure, axes = article.medium();
+	xticks = range(len(data[0]))
+	width = 0.8/(len(columns) - 1)
+	for i in range(1, len(columns)):
+		axes.bar([x + (i - 1)*width for x in xticks], 1/data[i], width=width, label=columns[i]);
+	axes.set(xlabel=xlabel, ylabel="speed (higher is better)", xticks=[x + 0.4 - width*0.5 for x in xticks], xticklabels=[str(int(x)) for x in data[0]]);
+	figure.save("%s.svg"%name)
+
+barPlot("filters_biquad_block_float", "block length")
+barPlot("filters_biquad_block_double", "block length")
+
+for type in ["float", "double"]:
+	for channels in [2, 8, 64]:
+		barPlot("filters_biquad_bank_%s_%i"%(type, channels), "channels")
+
+barPlot("filters_biquad_cascade_float", "order")
+barPlot("filters_biquad_cascade_double", "order")
+
+barPlot("filters_biquad_redesign", "design (bilinear/cookbook/oneSided)")
+
+barPlot("filters_biquad_parallel", "threads")
+
+barPlot("filters_crossover", "bands")
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <vector>
+
+#include "rates.h"
+
+namespace signalsmith_oversampler_v1 {
+	using signalsmith::rates::fillKaiserSinc;
+
+	// Full-length dot product for every output sample
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	struct Oversampler2xFIR {
+		Oversampler2xFIR() : Oversampler2xFIR(0, 0) {}
+		Oversampler2xFIR(int channels, int maxBlock, int halfLatency=16, double passFreq=0.43, const Allocator &allocator=Allocator()) : inputBuffer(allocator), halfSampleKernel(allocator), buffer(allocator) {
+			resize(channels, maxBlock, halfLatency, passFreq);
+		}
+		
+		void resize(int nChannels, int maxBlockLength) {
+			resize(nChannels, maxBlockLength, oneWayLatency);
+		}
+		void resize(int nChannels, int maxBlockLength, int halfLatency, double passFreq=0.43) {
+			oneWayLatency = halfLatency;
+			kernelLength = oneWayLatency*2;
+			channels = nChannels;
+			halfSampleKernel.resize(kernelLength);
+			fillKaiserSinc(halfSampleKernel, kernelLength, passFreq, 1 - passFreq);
+			inputStride = kernelLength + maxBlockLength;
+			inputBuffer.resize(channels*inputStride);
+			stride = (maxBlockLength + kernelLength)*2;
+			buffer.resize(stride*channels);
+		}
+
+		void reset() {
+			inputBuffer.assign(inputBuffer.size(), 0);
+			buffer.assign(buffer.size(), 0);
+		}
+
+		/// @brief Round-trip latency (or equivalently: upsample latency at the higher rate).
+		/// This will be twice the value passed into the constructor or `.resize()`.
+		int latency() const {
+			return kernelLength;
+		}
+		
+		/// Upsamples from a multi-channel input into the internal buffer
+		template<class Data>
+		void up(Data &&data, int lowSamples) {
+			for (int c = 0; c < channels; ++c) {
+				upChannel(c, data[c], lowSamples);
+			}
+		}
+
+		/// Upsamples a single-channel input into the internal buffer
+		template<class Data>
+		void upChannel(int c, Data &&data, int lowSamples) {
+			Sample *inputChannel = inputBuffer.data() + c*inputStride;
+			for (int i = 0; i < lowSamples; ++i) {
+				inputChannel[kernelLength + i] = data[i];
+			}
+			Sample *output = (*this)[c];
+			for (int i = 0; i < lowSamples; ++i) {
+				output[2*i] = inputChannel[i + oneWayLatency];
+				Sample *offsetInput = inputChannel + (i + 1);
+				Sample sum = 0;
+				for (int o = 0; o < kernelLength; ++o) {
+					sum += offsetInput[o]*halfSampleKernel[o];
+				}
+				output[2*i + 1] = sum;
+			}
+			// Copy the end of the buffer back to the beginning
+			for (int i = 0; i < kernelLength; ++i) {
+				inputChannel[i] = inputChannel[lowSamples + i];
+			}
+		}
+
+		/// Downsamples from the internal buffer to a multi-channel output
+		template<class Data>
+		void down(Data &&data, int lowSamples) {
+			for (int c = 0; c < channels; ++c) {
+				downChannel(c, data[c], lowSamples);
+			}
+		}
+
+		/// Downsamples a single channel from the internal buffer to a single-channel output
+		template<class Data>
+		void downChannel(int c, Data &&data, int lowSamples) {
+			Sample *input = buffer.data() + c*stride; // no offset for latency
+			for (int i = 0; i < lowSamples; ++i) {
+				Sample v1 = input[2*i + kernelLength];
+				Sample sum = 0;
+				for (int o = 0; o < kernelLength; ++o) {
+					Sample v2 = input[2*(i + o) + 1];
+					sum += v2*halfSampleKernel[o];
+				}
+				Sample v2 = sum;
+				Sample v = (v1 + v2)*Sample(0.5);
+				data[i] = v;
+			}
+			// Copy the end of the buffer back to the beginning
+			for (int i = 0; i < kernelLength*2; ++i) {
+				input[i] = input[lowSamples*2 + i];
+			}
+		}
+
+		/// Gets the samples for a single (higher-rate) channel.  The valid length depends how many input samples were passed into `.up()`/`.upChannel()`.
+		Sample * operator[](int c) {
+			return buffer.data() + kernelLength*2 + stride*c;
+		}
+		const Sample * operator[](int c) const {
+			return buffer.data() + kernelLength*2 + stride*c;
+		}
+
+	private:
+		int oneWayLatency, kernelLength;
+		int channels;
+		int stride, inputStride;
+		std::vector<Sample, Allocator> inputBuffer;
+		std::vector<Sample, Allocator> halfSampleKernel;
+		std::vector<Sample, Allocator> buffer;
+	};
+}
@@ -0,0 +1,51 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "rates.h"
+#include "./_previous/signalsmith-oversampler-v1.h"
+
+#include <vector>
+
+static constexpr int oversamplerInputLength = 65536;
+static constexpr int oversamplerChannels = 2;
+static constexpr int oversamplerBlock = 256;
+
+// Upsample and then downsample again, as an oversampled effect would
+template<typename Sample, class Oversampler>
+struct OversamplerRoundTrip {
+	Oversampler oversampler;
+	std::vector<std::vector<Sample>> input, output;
+	OversamplerRoundTrip(int halfLatency) : oversampler(oversamplerChannels, oversamplerBlock, halfLatency), input(oversamplerChannels, std::vector<Sample>(oversamplerInputLength)), output(input) {
+		for (int c = 0; c < oversamplerChannels; ++c) {
+			for (int i = 0; i < oversamplerInputLength; ++i) {
+				input[c][i] = Sample(((i + c*337)%1009)*7919%1009)/1009 - Sample(0.5);
+			}
+		}
+	}
+
+	inline void run() {
+		for (int start = 0; start < oversamplerInputLength; start += oversamplerBlock) {
+			for (int c = 0; c < oversamplerChannels; ++c) {
+				oversampler.upChannel(c, input[c].data() + start, oversamplerBlock);
+				oversampler.downChannel(c, output[c].data() + start, oversamplerBlock);
+			}
+		}
+	}
+};
+
+template<typename Sample>
+void benchmarkOversampler(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "half-latency");
+	benchmark.add<OversamplerRoundTrip<Sample, signalsmith_oversampler_v1::Oversampler2xFIR<Sample>>>("full kernel");
+	benchmark.add<OversamplerRoundTrip<Sample, signalsmith::rates::Oversampler2xFIR<Sample>>>("symmetric kernel");
+
+	for (int n = 8; n <= 64; n *= 2) {
+		test.log("N = ", n);
+		benchmark.run(n, oversamplerInputLength);
+	}
+}
+
+TEST("Oversampler 2x FIR") {
+	benchmarkOversampler<float>(test, "rates_oversampler_float");
+	benchmarkOversampler<double>(test, "rates_oversampler_double");
+}
@@ -0,0 +1,94 @@
+// from the shared library
+#include <test/benchmarks.h>
+
+#include "rates.h"
+
+#include <cmath>
+#include <vector>
+
+static constexpr int truePeakInputLength = 65536;
+static constexpr int truePeakChannels = 2;
+static constexpr int truePeakBlock = 256;
+
+template<typename Sample>
+struct TruePeakInput {
+	std::vector<std::vector<Sample>> input, output;
+	std::vector<Sample> peaks;
+	TruePeakInput() : input(truePeakChannels, std::vector<Sample>(truePeakInputLength)), output(input), peaks(truePeakChannels) {
+		for (int c = 0; c < truePeakChannels; ++c) {
+			for (int i = 0; i < truePeakInputLength; ++i) {
+				input[c][i] = Sample(((i + c*337)%1009)*7919%1009)/1009 - Sample(0.5);
+			}
+		}
+	}
+};
+
+// Two `Oversampler2xFIR`s, and a maximum over the 4x signal
+template<typename Sample>
+struct TruePeakComposed : public TruePeakInput<Sample> {
+	signalsmith::rates::Oversampler2xFIR<Sample> up2, up4;
+	TruePeakComposed(int halfLatency) : up2(truePeakChannels, truePeakBlock, halfLatency), up4(truePeakChannels, truePeakBlock*2, halfLatency) {}
+
+	inline void run() {
+		for (int start = 0; start < truePeakInputLength; start += truePeakBlock) {
+			for (int c = 0; c < truePeakChannels; ++c) {
+				up2.upChannel(c, this->input[c].data() + start, truePeakBlock);
+				up4.upChannel(c, up2[c], truePeakBlock*2);
+				const Sample *oversampled = up4[c];
+				Sample peak = this->peaks[c];
+				for (int i = 0; i < truePeakBlock*4; ++i) peak = std::max(peak, std::abs(oversampled[i]));
+				this->peaks[c] = peak;
+			}
+		}
+	}
+};
+
+template<typename Sample>
+struct TruePeakPolyphase : public TruePeakInput<Sample> {
+	signalsmith::rates::TruePeak<Sample> truePeak;
+	TruePeakPolyphase(int halfLatency) : truePeak(truePeakChannels, halfLatency) {}
+
+	inline void run() {
+		std::vector<const Sample *> input(truePeakChannels);
+		for (int start = 0; start < truePeakInputLength; start += truePeakBlock) {
+			for (int c = 0; c < truePeakChannels; ++c) input[c] = this->input[c].data() + start;
+			truePeak.process(input, truePeakBlock);
+		}
+		for (int c = 0; c < truePeakChannels; ++c) this->peaks[c] = truePeak.peak(c);
+	}
+};
+
+template<typename Sample>
+struct TruePeakPolyphaseOutput : public TruePeakPolyphase<Sample> {
+	using TruePeakPolyphase<Sample>::TruePeakPolyphase;
+
+	inline void run() {
+		std::vector<const Sample *> input(truePeakChannels);
+		std::vector<Sample *> output(truePeakChannels);
+		for (int start = 0; start < truePeakInputLength; start += truePeakBlock) {
+			for (int c = 0; c < truePeakChannels; ++c) {
+				input[c] = this->input[c].data() + start;
+				output[c] = this->output[c].data() + start;
+			}
+			this->truePeak.process(input, output, truePeakBlock);
+		}
+	}
+};
+
+template<typename Sample>
+void benchmarkTruePeak(Test &test, std::string name) {
+	Benchmark<int> benchmark(name, "half-latency");
+	benchmark.add<TruePeakComposed<Sample>>("2x Oversampler2xFIR");
+	benchmark.add<TruePeakPolyphase<Sample>>("TruePeak");
+	benchmark.add<TruePeakPolyphaseOutput<Sample>>("TruePeak (per-sample output)");
+
+	for (int n = 4; n <= 32; n *= 2) {
+		test.log("N = ", n);
+		benchmark.run(n, truePeakInputLength);
+	}
+}
+
+TEST("True peak") {
+	benchmarkTruePeak<float>(test, "rates_true_peak_float");
+	benchmarkTruePeak<double>(test, "rates_true_peak_double");
+}
@@ -5,8 +5,13 @@
 
 #include <vector>
 #include <array>
+#include <memory> // for std::allocator
+#include <algorithm>
+#include <atomic>
 #include <cmath> // for std::ceil()
 #include <type_traits>
+#include <cstdint>
+#include <cstring> // for std::memcpy()
 
 #include <complex>
 #include "./fft.h"
@@ -25,6 +30,187 @@ namespace delay {
 		@file
 	*/
 
+	/** @defgroup Storage Sample storage
+		@brief Policies for how `Buffer`/`MultiBuffer` store samples
+		@ingroup Delay
+
+		The compact formats convert on every read/write, so interpolators (and everything else) still see `Sample` values.  Accessing a compact buffer returns a reference-like proxy rather than a `Sample &`.
+
+		Impulse measurements are unchanged (since `0` and `1` are exact in all formats), but quantisation adds noise.  Measured error for uniform white noise in ±1 through a cubic-interpolated delay (see `tests/delay/05-compact-storage.cpp`):
+
+		| Storage            | bytes/sample     | error (relative to signal) |
+		|--------------------|------------------|----------------------------|
+		| `StorageNative`    | `sizeof(Sample)` | -                          |
+		| `StorageInt24`     | 3                | -144 dB                    |
+		| `StorageInt16`     | 2                | -96 dB                     |
+		| `StorageFloat16`   | 2                | -74 dB                     |
+
+		The integer formats are scaled so that ±1 is full-scale (and clip outside that), while `StorageFloat16` has a constant relative error but a range of ±65504.
+		@{ */
+	/// Stores samples directly (the default)
+	template<typename Sample>
+	struct StorageNative {
+		using Stored = Sample;
+		using Reference = Sample &;
+		using ConstReference = const Sample &;
+
+		static Stored store(Sample value) {
+			return value;
+		}
+		static Reference reference(Stored &stored) {
+			return stored;
+		}
+		static ConstReference reference(const Stored &stored) {
+			return stored;
+		}
+	};
+
+	namespace _storage_impl {
+		/// Reference-like proxy, converting on read/write
+		template<typename Sample, class Format>
+		class StoredReference {
+			typename Format::Stored &stored;
+		public:
+			StoredReference(typename Format::Stored &stored) : stored(stored) {}
+			StoredReference(const StoredReference &other) = default;
+
+			operator Sample() const {
+				return Format::decode(stored);
+			}
+			StoredReference & operator =(Sample value) {
+				stored = Format::encode(value);
+				return *this;
+			}
+			StoredReference & operator =(const StoredReference &other) {
+				return *this = Sample(other);
+			}
+			StoredReference & operator +=(Sample value) {
+				return *this = Sample(*this) + value;
+			}
+			StoredReference & operator -=(Sample value) {
+				return *this = Sample(*this) - value;
+			}
+			StoredReference & operator *=(Sample value) {
+				return *this = Sample(*this)*value;
+			}
+		};
+
+		template<typename Sample, class Format>
+		struct Storage {
+			using Stored = typename Format::Stored;
+			using Reference = StoredReference<Sample, Format>;
+			using ConstReference = Sample;
+
+			static Stored store(Sample value) {
+				return Format::encode(value);
+			}
+			static Reference reference(Stored &stored) {
+				return Reference(stored);
+			}
+			static ConstReference reference(const Stored &stored) {
+				return Format::decode(stored);
+			}
+		};
+
+		struct Float16 {
+			using Stored = uint16_t;
+
+			// Round-to-nearest-even, based on Fabian Giesen's public-domain conversions
+			static Stored encode(float value) {
+				uint32_t bits = floatBits(value);
+				uint32_t sign = bits&0x80000000u;
+				bits ^= sign;
+				uint16_t result;
+				if (bits >= (127u + 16)<<23) { // too big, Inf or NaN
+					result = (bits > 0x7F800000u) ? 0x7E00 : 0x7C00;
+				} else if (bits < 113u<<23) { // subnormal (or zero)
+					// Adding a magic number aligns the mantissa bits, and the FPU does the rounding
+					const uint32_t magicBits = ((127u - 15) + (23 - 10) + 1)<<23;
+					result = uint16_t(floatBits(bitsFloat(bits) + bitsFloat(magicBits)) - magicBits);
+				} else {
+					uint32_t mantissaOdd = (bits>>13)&1;
+					bits += (uint32_t(15 - 127)<<23) + 0xFFF + mantissaOdd;
+					result = uint16_t(bits>>13);
+				}
+				return result|uint16_t(sign>>16);
+			}
+			static float decode(Stored half) {
+				const uint32_t shiftedExp = 0x7C00u<<13;
+				uint32_t bits = (half&0x7FFFu)<<13;
+				uint32_t exp = bits&shiftedExp;
+				bits += (127u - 15)<<23;
+				if (exp == shiftedExp) { // Inf or NaN
+					bits += (128u - 16)<<23;
+				} else if (exp == 0) { // zero or subnormal, renormalise
+					bits += 1u<<23;
+					bits = floatBits(bitsFloat(bits) - bitsFloat(113u<<23));
+				}
+				return bitsFloat(bits|(uint32_t(half&0x8000u)<<16));
+			}
+		private:
+			static uint32_t floatBits(float f) {
+				uint32_t bits;
+				std::memcpy(&bits, &f, sizeof(bits));
+				return bits;
+			}
+			static float bitsFloat(uint32_t bits) {
+				float f;
+				std::memcpy(&f, &bits, sizeof(f));
+				return f;
+			}
+		};
+
+		template<typename Sample, int bits>
+		struct ScaledInt {
+			static constexpr int32_t maxInt = (int32_t(1)<<(bits - 1)) - 1;
+
+			static int32_t toInt(Sample value) {
+				Sample scaled = value*Sample(maxInt);
+				scaled = std::max<Sample>(-maxInt, std::min<Sample>(maxInt, scaled));
+				return int32_t(scaled + (scaled >= 0 ? Sample(0.5) : Sample(-0.5)));
+			}
+			static Sample fromInt(int32_t value) {
+				return value*(Sample(1)/maxInt);
+			}
+		};
+		template<typename Sample>
+		struct Int16 : public ScaledInt<Sample, 16> {
+			using Stored = int16_t;
+			static Stored encode(Sample value) {
+				return Stored(Int16::toInt(value));
+			}
+			static Sample decode(Stored stored) {
+				return Int16::fromInt(stored);
+			}
+		};
+		template<typename Sample>
+		struct Int24 : public ScaledInt<Sample, 24> {
+			struct Stored {
+				uint8_t bytes[3];
+			};
+			static Stored encode(Sample value) {
+				uint32_t v = uint32_t(Int24::toInt(value));
+				return {{uint8_t(v), uint8_t(v>>8), uint8_t(v>>16)}};
+			}
+			static Sample decode(Stored stored) {
+				// Put the top byte at the top, so the arithmetic shift extends the sign
+				uint32_t v = (uint32_t(stored.bytes[0])<<8)|(uint32_t(stored.bytes[1])<<16)|(uint32_t(stored.bytes[2])<<24);
+				return Int24::fromInt(int32_t(v)>>8);
+			}
+		};
+	}
+
+	/// Stores samples as IEEE half-precision floats
+	template<typename Sample>
+	struct StorageFloat16 : public _storage_impl::Storage<Sample, _storage_impl::Float16> {};
+	/// Stores samples as 16-bit integers, with ±1 as full-scale
+	template<typename Sample>
+	struct StorageInt16 : public _storage_impl::Storage<Sample, _storage_impl::Int16<Sample>> {};
+	/// Stores samples as (packed, 3-byte) 24-bit integers, with ±1 as full-scale
+	template<typename Sample>
+	struct StorageInt24 : public _storage_impl::Storage<Sample, _storage_impl::Int24<Sample>> {};
+	/// @}
+
 	/** @brief Single-channel delay buffer
  
 		Access is used with `buffer[]`, relative to the internal read/write position ("head").  This head is moved using `++buffer` (or `buffer += n`), such that `buffer[1] == (buffer + 1)[0]` in a similar way iterators/pointers.
@@ -38,14 +224,22 @@ namespace delay {
 		* `buffer[0]` to buffer[99]`
 
 		Although buffers are usually used with historical samples accessed using negative indices e.g. `buffer[-10]`, you could equally use it flipped around (moving the head backwards through the buffer using `--buffer`).
+
+		The sample format in memory is chosen by a template class from @ref Storage.  Memory is taken from `Allocator` (e.g. `perf::ArenaAllocator`), which is passed as the last constructor argument.
 	*/
-	template<typename Sample>
+	template<typename Sample, template<typename> class Storage=StorageNative, class Allocator=std::allocator<Sample>>
 	class Buffer {
+		using StorageImpl = Storage<Sample>;
+		using Stored = typename StorageImpl::Stored;
+		using StoredAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Stored>;
 		unsigned bufferIndex;
 		unsigned bufferMask;
-		std::vector<Sample> buffer;
+		std::vector<Stored, StoredAllocator> buffer;
 	public:
-		Buffer(int minCapacity=0) {
+		using Reference = typename StorageImpl::Reference;
+		using ConstReference = typename StorageImpl::ConstReference;
+
+		Buffer(int minCapacity=0, const Allocator &allocator=Allocator()) : buffer(StoredAllocator(allocator)) {
 			resize(minCapacity);
 		}
 		// We shouldn't accidentally copy a delay buffer
@@ -58,19 +252,23 @@ namespace delay {
 		void resize(int minCapacity, Sample value=Sample()) {
 			int bufferLength = 1;
 			while (bufferLength < minCapacity) bufferLength *= 2;
-			buffer.assign(bufferLength, value);
+			buffer.assign(bufferLength, StorageImpl::store(value));
 			bufferMask = unsigned(bufferLength - 1);
 			bufferIndex = 0;
 		}
 		void reset(Sample value=Sample()) {
-			buffer.assign(buffer.size(), value);
+			buffer.assign(buffer.size(), StorageImpl::store(value));
+		}
+		/// The actual capacity (the requested minimum, rounded up to a power of 2)
+		int capacity() const {
+			return int(bufferMask + 1);
 		}
 
 		/// Holds a view for a particular position in the buffer
 		template<bool isConst>
 		class View {
 			using CBuffer = typename std::conditional<isConst, const Buffer, Buffer>::type;
-			using CSample = typename std::conditional<isConst, const Sample, Sample>::type;
+			using CReference = typename std::conditional<isConst, ConstReference, Reference>::type;
 			CBuffer *buffer = nullptr;
 			unsigned bufferIndex = 0;
 		public:
@@ -82,11 +280,12 @@ namespace delay {
 				return *this;
 			}
 			
-			CSample & operator[](int offset) {
-				return buffer->buffer[(bufferIndex + (unsigned)offset)&buffer->bufferMask];
+			CReference operator[](int offset) {
+				return StorageImpl::reference(buffer->buffer[(bufferIndex + (unsigned)offset)&buffer->bufferMask]);
 			}
-			const Sample & operator[](int offset) const {
-				return buffer->buffer[(bufferIndex + (unsigned)offset)&buffer->bufferMask];
+			ConstReference operator[](int offset) const {
+				const Stored &stored = buffer->buffer[(bufferIndex + (unsigned)offset)&buffer->bufferMask];
+				return StorageImpl::reference(stored);
 			}
 
 			/// Write data into the buffer
@@ -124,11 +323,11 @@ namespace delay {
 			return ConstView(*this, offset);
 		}
 
-		Sample & operator[](int offset) {
-			return buffer[(bufferIndex + (unsigned)offset)&bufferMask];
+		Reference operator[](int offset) {
+			return StorageImpl::reference(buffer[(bufferIndex + (unsigned)offset)&bufferMask]);
 		}
-		const Sample & operator[](int offset) const {
-			return buffer[(bufferIndex + (unsigned)offset)&bufferMask];
+		ConstReference operator[](int offset) const {
+			return StorageImpl::reference(buffer[(bufferIndex + (unsigned)offset)&bufferMask]);
 		}
 
 		/// Write data into the buffer
@@ -193,16 +392,23 @@ namespace delay {
 		
 		* `buffer[c]` returns a view for a single channel, which behaves like the single-channel `Buffer::View`.
 		* The constructor and `.resize()` take an additional first `channel` argument.
+
+		By default, each channel is stored as a separate contiguous region.  If `interleaved` is enabled, all the channels for a given sample are stored next to each other instead (see `MultiBuffer<Sample, true>`).
+
+		As with `Buffer`, the sample format in memory is chosen from @ref Storage, and memory is taken from `Allocator`.
 	*/
-	template<typename Sample>
+	template<typename Sample, bool interleaved=false, template<typename> class Storage=StorageNative, class Allocator=std::allocator<Sample>>
 	class MultiBuffer {
+		using BufferType = Buffer<Sample, Storage, Allocator>;
 		int channels, stride;
-		Buffer<Sample> buffer;
+		BufferType buffer;
 	public:
-		using ConstChannel = typename Buffer<Sample>::ConstView;
-		using MutableChannel = typename Buffer<Sample>::MutableView;
+		using ConstChannel = typename BufferType::ConstView;
+		using MutableChannel = typename BufferType::MutableView;
+		using Reference = typename BufferType::Reference;
+		using ConstReference = typename BufferType::ConstReference;
 
-		MultiBuffer(int channels=0, int capacity=0) : channels(channels), stride(capacity), buffer(channels*capacity) {}
+		MultiBuffer(int channels=0, int capacity=0, const Allocator &allocator=Allocator()) : channels(channels), stride(capacity), buffer(channels*capacity, allocator) {}
 
 		void resize(int nChannels, int capacity, Sample value=Sample()) {
 			channels = nChannels;
@@ -217,17 +423,17 @@ namespace delay {
 		template<bool isConst>
 		class Stride {
 			using CChannel = typename std::conditional<isConst, ConstChannel, MutableChannel>::type;
-			using CSample = typename std::conditional<isConst, const Sample, Sample>::type;
+			using CReference = typename std::conditional<isConst, ConstReference, Reference>::type;
 			CChannel view;
 			int channels, stride;
 		public:
 			Stride(CChannel view, int channels, int stride) : view(view), channels(channels), stride(stride) {}
 			Stride(const Stride &other) : view(other.view), channels(other.channels), stride(other.stride) {}
 			
-			CSample & operator[](int channel) {
+			CReference operator[](int channel) {
 				return view[channel*stride];
 			}
-			const Sample & operator[](int channel) const {
+			ConstReference operator[](int channel) const {
 				return view[channel*stride];
 			}
 
@@ -342,6 +548,430 @@ namespace delay {
 		}
 	};
 	
+	/** @brief Multi-channel delay buffer, with interleaved (frame-major) storage
+
+		This has the same API as the default `MultiBuffer`, but all channels for a particular sample index are adjacent in memory.  This is more cache-friendly when every channel is accessed for each sample (e.g. in a feedback delay network), and `.at()` results can be processed as a contiguous block.
+
+		The capacity is rounded up to a power of two (in samples, not including channels), so a frame is never split across the wrap-around point.
+	*/
+	template<typename Sample, template<typename> class Storage, class Allocator>
+	class MultiBuffer<Sample, true, Storage, Allocator> {
+		using StorageImpl = Storage<Sample>;
+		using Stored = typename StorageImpl::Stored;
+		using StoredAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Stored>;
+		int channels;
+		unsigned frameIndex, frameMask;
+		std::vector<Stored, StoredAllocator> buffer;
+	public:
+		using Reference = typename StorageImpl::Reference;
+		using ConstReference = typename StorageImpl::ConstReference;
+
+		MultiBuffer(int channels=0, int capacity=0, const Allocator &allocator=Allocator()) : buffer(StoredAllocator(allocator)) {
+			resize(channels, capacity);
+		}
+		// We shouldn't accidentally copy a delay buffer
+		MultiBuffer(const MultiBuffer &other) = delete;
+		MultiBuffer & operator =(const MultiBuffer &other) = delete;
+		// But moving one is fine
+		MultiBuffer(MultiBuffer &&other) = default;
+		MultiBuffer & operator =(MultiBuffer &&other) = default;
+
+		void resize(int nChannels, int capacity, Sample value=Sample()) {
+			channels = nChannels;
+			int frameLength = 1;
+			while (frameLength < capacity) frameLength *= 2;
+			buffer.assign(frameLength*channels, StorageImpl::store(value));
+			frameMask = unsigned(frameLength - 1);
+			frameIndex = 0;
+		}
+		void reset(Sample value=Sample()) {
+			buffer.assign(buffer.size(), StorageImpl::store(value));
+		}
+
+		/// A single-channel view, which behaves like the single-channel `Buffer::View`
+		template<bool isConst>
+		class ChannelView {
+			using CBuffer = typename std::conditional<isConst, const MultiBuffer, MultiBuffer>::type;
+			using CReference = typename std::conditional<isConst, ConstReference, Reference>::type;
+			CBuffer *buffer = nullptr;
+			unsigned frameIndex = 0;
+			int channel = 0;
+		public:
+			ChannelView(CBuffer &buffer, int channel, int offset=0) : buffer(&buffer), frameIndex(buffer.frameIndex + (unsigned)offset), channel(channel) {}
+			ChannelView(const ChannelView &other, int offset=0) : buffer(other.buffer), frameIndex(other.frameIndex + (unsigned)offset), channel(other.channel) {}
+			ChannelView & operator =(const ChannelView &other) {
+				buffer = other.buffer;
+				frameIndex = other.frameIndex;
+				channel = other.channel;
+				return *this;
+			}
+
+			CReference operator[](int offset) {
+				return StorageImpl::reference(buffer->buffer[((frameIndex + (unsigned)offset)&buffer->frameMask)*buffer->channels + channel]);
+			}
+			ConstReference operator[](int offset) const {
+				const Stored &stored = buffer->buffer[((frameIndex + (unsigned)offset)&buffer->frameMask)*buffer->channels + channel];
+				return StorageImpl::reference(stored);
+			}
+
+			/// Write data into the buffer
+			template<typename Data>
+			void write(Data &&data, int length) {
+				for (int i = 0; i < length; ++i) {
+					(*this)[i] = data[i];
+				}
+			}
+			/// Read data out from the buffer
+			template<typename Data>
+			void read(int length, Data &&data) const {
+				for (int i = 0; i < length; ++i) {
+					data[i] = (*this)[i];
+				}
+			}
+
+			ChannelView operator +(int offset) const {
+				return ChannelView(*this, offset);
+			}
+			ChannelView operator -(int offset) const {
+				return ChannelView(*this, -offset);
+			}
+		};
+		using ConstChannel = ChannelView<true>;
+		using MutableChannel = ChannelView<false>;
+
+		/// A reference-like multi-channel result for a particular sample index.  The channels are contiguous, so `.data()` can be used for block operations.
+		template<bool isConst>
+		class Stride {
+			using CStored = typename std::conditional<isConst, const Stored, Stored>::type;
+			using CReference = typename std::conditional<isConst, ConstReference, Reference>::type;
+			CStored *frame;
+			int channels;
+		public:
+			Stride(CStored *frame, int channels) : frame(frame), channels(channels) {}
+			Stride(const Stride &other) : frame(other.frame), channels(other.channels) {}
+
+			CReference operator[](int channel) {
+				return StorageImpl::reference(frame[channel]);
+			}
+			ConstReference operator[](int channel) const {
+				const Stored &stored = frame[channel];
+				return StorageImpl::reference(stored);
+			}
+			/// The stored values (which are `Sample`s unless using a compact @ref Storage)
+			CStored * data() {
+				return frame;
+			}
+			const Stored * data() const {
+				return frame;
+			}
+
+			/// Reads from the buffer into a multi-channel result
+			template<class Data>
+			void get(Data &&result) const {
+				for (int c = 0; c < channels; ++c) {
+					result[c] = (*this)[c];
+				}
+			}
+			/// Writes from multi-channel data into the buffer
+			template<class Data>
+			void set(Data &&data) {
+				for (int c = 0; c < channels; ++c) {
+					frame[c] = StorageImpl::store(data[c]);
+				}
+			}
+			template<class Data>
+			Stride & operator =(const Data &data) {
+				set(data);
+				return *this;
+			}
+			Stride & operator =(const Stride &data) {
+				set(data);
+				return *this;
+			}
+		};
+
+		Stride<false> at(int offset) {
+			return {frame(frameIndex + (unsigned)offset), channels};
+		}
+		Stride<true> at(int offset) const {
+			return {frame(frameIndex + (unsigned)offset), channels};
+		}
+
+		/// Holds a particular position in the buffer
+		template<bool isConst>
+		class View {
+			using CBuffer = typename std::conditional<isConst, const MultiBuffer, MultiBuffer>::type;
+			using CChannel = typename std::conditional<isConst, ConstChannel, MutableChannel>::type;
+			CBuffer *buffer;
+			unsigned frameIndex;
+		public:
+			View(CBuffer &buffer, int offset) : buffer(&buffer), frameIndex(buffer.frameIndex + (unsigned)offset) {}
+
+			CChannel operator[](int channel) {
+				return CChannel(*buffer, channel, int(frameIndex - buffer->frameIndex));
+			}
+			ConstChannel operator[](int channel) const {
+				return ConstChannel(*buffer, channel, int(frameIndex - buffer->frameIndex));
+			}
+
+			Stride<isConst> at(int offset) {
+				return {buffer->frame(frameIndex + (unsigned)offset), buffer->channels};
+			}
+			Stride<true> at(int offset) const {
+				return {buffer->frame(frameIndex + (unsigned)offset), buffer->channels};
+			}
+		};
+		using MutableView = View<false>;
+		using ConstView = View<true>;
+
+		MutableView view(int offset=0) {
+			return MutableView(*this, offset);
+		}
+		ConstView view(int offset=0) const {
+			return ConstView(*this, offset);
+		}
+		ConstView constView(int offset=0) const {
+			return ConstView(*this, offset);
+		}
+
+		MutableChannel operator[](int channel) {
+			return MutableChannel(*this, channel);
+		}
+		ConstChannel operator[](int channel) const {
+			return ConstChannel(*this, channel);
+		}
+
+		MultiBuffer & operator ++() {
+			++frameIndex;
+			return *this;
+		}
+		MultiBuffer & operator +=(int i) {
+			frameIndex += (unsigned)i;
+			return *this;
+		}
+		MutableView operator ++(int) {
+			MutableView result(*this, 0);
+			++frameIndex;
+			return result;
+		}
+		MutableView operator +(int i) {
+			return MutableView(*this, i);
+		}
+		ConstView operator +(int i) const {
+			return ConstView(*this, i);
+		}
+		MultiBuffer & operator --() {
+			--frameIndex;
+			return *this;
+		}
+		MultiBuffer & operator -=(int i) {
+			frameIndex -= (unsigned)i;
+			return *this;
+		}
+		MutableView operator --(int) {
+			MutableView result(*this, 0);
+			--frameIndex;
+			return result;
+		}
+		MutableView operator -(int i) {
+			return MutableView(*this, -i);
+		}
+		ConstView operator -(int i) const {
+			return ConstView(*this, -i);
+		}
+	private:
+		Stored * frame(unsigned index) {
+			return buffer.data() + (index&frameMask)*channels;
+		}
+		const Stored * frame(unsigned index) const {
+			return buffer.data() + (index&frameMask)*channels;
+		}
+	};
+	
+	namespace _ring_impl {
+		// Read/write positions for a single-producer/single-consumer queue.  These only ever increase (wrapping around) - the difference is the number of samples available.
+		struct Indices {
+			static constexpr int cacheLine = 64;
+			// Each side's index is on its own cache line, along with a local copy of the other side's index.  The copy is only refreshed when it looks like there isn't enough space/data, so the threads don't keep invalidating each other's lines.
+			struct Side {
+				std::atomic<unsigned> index{0};
+				unsigned other = 0;
+			};
+			char padStart[cacheLine];
+			Side writer;
+			char padMiddle[cacheLine];
+			Side reader;
+			char padEnd[cacheLine];
+
+			void reset() {
+				writer.index.store(0);
+				writer.other = 0;
+				reader.index.store(0);
+				reader.other = 0;
+			}
+
+			int writeAvailable(int capacity) const {
+				return capacity - int(writer.index.load(std::memory_order_relaxed) - reader.index.load(std::memory_order_acquire));
+			}
+			// Limits `length` to the space available, returning the write position
+			unsigned beginWrite(int capacity, int &length) {
+				unsigned index = writer.index.load(std::memory_order_relaxed);
+				if (length > capacity - int(index - writer.other)) {
+					writer.other = reader.index.load(std::memory_order_acquire);
+					length = std::min(length, capacity - int(index - writer.other));
+				}
+				return index;
+			}
+			void endWrite(unsigned index, int length) {
+				writer.index.store(index + unsigned(length), std::memory_order_release);
+			}
+
+			int readAvailable() const {
+				return int(writer.index.load(std::memory_order_acquire) - reader.index.load(std::memory_order_relaxed));
+			}
+			// Limits `length` to the data available, returning the read position
+			unsigned beginRead(int &length) {
+				unsigned index = reader.index.load(std::memory_order_relaxed);
+				if (length > int(reader.other - index)) {
+					reader.other = writer.index.load(std::memory_order_acquire);
+					length = std::min(length, int(reader.other - index));
+				}
+				return index;
+			}
+			void endRead(unsigned index, int length) {
+				reader.index.store(index + unsigned(length), std::memory_order_release);
+			}
+
+			// Buffer indices are `int`, but any value congruent modulo its (power-of-2) length is equivalent
+			static int position(unsigned index) {
+				return int(index&0x7FFFFFFFu);
+			}
+		};
+	}
+
+	/** @brief Lock-free single-producer/single-consumer ring buffer, for passing audio between threads
+
+		One thread writes (using `.write()`/`.writeAvailable()`) and one thread reads (using `.read()`/`.readAvailable()`).  Both sides are wait-free: if there isn't enough space (or data), they process as much as they can, and return the number of samples actually written (or read).
+		\code
+			// Real-time thread
+			int written = ring.write(block, blockLength);
+			if (written < blockLength) ++droppedBlocks;
+
+			// Disk thread
+			int length = ring.read(ring.readAvailable(), diskBuffer);
+		\endcode
+
+		The samples are stored in a `Buffer`, so the sample format (@ref Storage) and `Allocator` can be chosen in the same way.  Nothing is allocated after construction or `.resize()` - which (like `.reset()`) must not be called while either thread is using it.
+
+		The read and write positions are padded onto separate cache lines, so this object is a few hundred bytes.
+	*/
+	template<typename Sample, template<typename> class Storage=StorageNative, class Allocator=std::allocator<Sample>>
+	class RingBuffer {
+		Buffer<Sample, Storage, Allocator> buffer;
+		int _capacity;
+		_ring_impl::Indices indices;
+	public:
+		RingBuffer(int capacity=0, const Allocator &allocator=Allocator()) : buffer(capacity, allocator), _capacity(capacity) {}
+
+		void resize(int capacity, Sample value=Sample()) {
+			buffer.resize(capacity, value);
+			_capacity = capacity;
+			reset(value);
+		}
+		/// Empties the buffer
+		void reset(Sample value=Sample()) {
+			buffer.reset(value);
+			indices.reset();
+		}
+		int capacity() const {
+			return _capacity;
+		}
+
+		/// Space available for writing (called from the writing thread)
+		int writeAvailable() const {
+			return indices.writeAvailable(_capacity);
+		}
+		/// Writes up to `length` samples, returning the number actually written
+		template<class Data>
+		int write(Data &&data, int length) {
+			unsigned index = indices.beginWrite(_capacity, length);
+			(buffer + indices.position(index)).write(data, length);
+			indices.endWrite(index, length);
+			return length;
+		}
+
+		/// Samples available for reading (called from the reading thread)
+		int readAvailable() const {
+			return indices.readAvailable();
+		}
+		/// Reads up to `length` samples, returning the number actually read
+		template<class Data>
+		int read(int length, Data &&data) {
+			unsigned index = indices.beginRead(length);
+			(buffer + indices.position(index)).read(length, data);
+			indices.endRead(index, length);
+			return length;
+		}
+	};
+
+	/** @brief Multi-channel version of `RingBuffer`, using a `MultiBuffer` for storage
+
+		`.write()` and `.read()` take multi-channel data, where `data[c][i]` is a sample.  All channels move together, so the counts returned are the same for every channel.
+	*/
+	template<typename Sample, bool interleaved=false, template<typename> class Storage=StorageNative, class Allocator=std::allocator<Sample>>
+	class MultiRingBuffer {
+		MultiBuffer<Sample, interleaved, Storage, Allocator> buffer;
+		int channels, _capacity;
+		_ring_impl::Indices indices;
+	public:
+		MultiRingBuffer(int channels=0, int capacity=0, const Allocator &allocator=Allocator()) : buffer(channels, capacity, allocator), channels(channels), _capacity(capacity) {}
+
+		void resize(int nChannels, int capacity, Sample value=Sample()) {
+			buffer.resize(nChannels, capacity, value);
+			channels = nChannels;
+			_capacity = capacity;
+			reset(value);
+		}
+		/// Empties the buffer
+		void reset(Sample value=Sample()) {
+			buffer.reset(value);
+			indices.reset();
+		}
+		int capacity() const {
+			return _capacity;
+		}
+
+		/// Space available for writing (called from the writing thread)
+		int writeAvailable() const {
+			return indices.writeAvailable(_capacity);
+		}
+		/// Writes up to `length` samples on every channel, returning the number actually written
+		template<class Data>
+		int write(Data &&data, int length) {
+			unsigned index = indices.beginWrite(_capacity, length);
+			for (int c = 0; c < channels; ++c) {
+				(buffer[c] + indices.position(index)).write(data[c], length);
+			}
+			indices.endWrite(index, length);
+			return length;
+		}
+
+		/// Samples available for reading (called from the reading thread)
+		int readAvailable() const {
+			return indices.readAvailable();
+		}
+		/// Reads up to `length` samples from every channel, returning the number actually read
+		template<class Data>
+		int read(int length, Data &&data) {
+			unsigned index = indices.beginRead(length);
+			for (int c = 0; c < channels; ++c) {
+				(buffer[c] + indices.position(index)).read(length, data[c]);
+			}
+			indices.endRead(index, length);
+			return length;
+		}
+	};
+
 	/** \defgroup Interpolators Interpolators
 		\ingroup Delay
 		@{ */
@@ -465,6 +1095,100 @@ namespace delay {
 	template<typename Sample>
 	using InterpolatorLagrange19 = InterpolatorLagrangeN<Sample, 19>;
 
+	/** Fixed-order Lagrange interpolation, using the Farrow structure.
+	This gives the same results as `InterpolatorLagrangeN`, but splits the work into two parts.  The polynomial coefficients (the outputs of `n + 1` FIR sub-filters) only depend on the input position, and can be re-used for any number of fractional reads with Horner's method:
+	\code
+		InterpolatorLagrangeFarrowN<float, 7> farrow;
+		auto poly = farrow.polynomial(data); // O(n^2)
+		for (int t = 0; t < taps; ++t) {
+			output[t] = farrow.evaluate(poly, fractions[t]); // O(n)
+		}
+		// or all at once (vectorised across taps)
+		farrow.evaluate(poly, fractions, output, taps);
+	\endcode
+	For a single read it's slower than `InterpolatorLagrangeN`, but it's a drop-in replacement with the same `inputLength`/`latency`.
+	*/
+	template<typename Sample, int n>
+	struct InterpolatorLagrangeFarrowN {
+		static constexpr int inputLength = n + 1;
+		static constexpr int latency = (n - 1)/2;
+
+		using Array = std::array<Sample, (n + 1)>;
+		/// Sub-filter coefficients: `subFilters[j][m]` is the contribution of `data[j]` to the `fractional^m` term
+		std::array<Array, (n + 1)> subFilters;
+
+		InterpolatorLagrangeFarrowN() {
+			for (int j = 0; j <= n; ++j) {
+				// Expand the Lagrange basis polynomial for `data[j]`, in terms of the fractional part
+				std::array<double, (n + 1)> basis;
+				basis[0] = 1;
+				int order = 0;
+				for (int k = 0; k <= n; ++k) {
+					if (k == j) continue;
+					double scale = 1.0/(j - k), offset = (latency - k)*scale;
+					++order;
+					basis[order] = 0;
+					for (int m = order; m > 0; --m) {
+						basis[m] = basis[m]*offset + basis[m - 1]*scale;
+					}
+					basis[0] *= offset;
+				}
+				for (int m = 0; m <= n; ++m) {
+					subFilters[j][m] = basis[m];
+				}
+			}
+		}
+
+		/// Calculates the polynomial (in the fractional part) for a given input position
+		template<class Data>
+		Array polynomial(const Data &data) const {
+			Array result;
+			for (int m = 0; m <= n; ++m) {
+				result[m] = 0;
+			}
+			for (int j = 0; j <= n; ++j) {
+				Sample v = data[j];
+				const Array &filter = subFilters[j];
+				for (int m = 0; m <= n; ++m) {
+					result[m] += filter[m]*v;
+				}
+			}
+			return result;
+		}
+		/// Evaluates the polynomial for a fractional position
+		static Sample evaluate(const Array &poly, Sample fractional) {
+			Sample result = poly[n];
+			for (int m = n - 1; m >= 0; --m) {
+				result = result*fractional + poly[m];
+			}
+			return result;
+		}
+		/// Evaluates the polynomial for many fractional positions at once.  The loop runs across taps, so it can be vectorised (and isn't limited by the latency of each Horner step).
+		template<class Fractions, class Output>
+		static void evaluate(const Array &poly, Fractions &&fractions, Output &&output, int count) {
+			for (int t = 0; t < count; ++t) {
+				output[t] = poly[n];
+			}
+			for (int m = n - 1; m >= 0; --m) {
+				Sample coeff = poly[m];
+				for (int t = 0; t < count; ++t) {
+					output[t] = output[t]*fractions[t] + coeff;
+				}
+			}
+		}
+
+		template<class Data>
+		Sample fractional(const Data &data, Sample fractional) const {
+			return evaluate(polynomial(data), fractional);
+		}
+	};
+	template<typename Sample>
+	using InterpolatorLagrangeFarrow3 = InterpolatorLagrangeFarrowN<Sample, 3>;
+	template<typename Sample>
+	using InterpolatorLagrangeFarrow7 = InterpolatorLagrangeFarrowN<Sample, 7>;
+	template<typename Sample>
+	using InterpolatorLagrangeFarrow19 = InterpolatorLagrangeFarrowN<Sample, 19>;
+
 	/** Fixed-size Kaiser-windowed sinc interpolation.
 	\diagram{interpolator-KaiserSincN.svg,aliasing and amplitude/delay errors for different sizes}
 	If `minimumPhase` is enabled, a minimum-phase version of the kernel is used:
@@ -607,17 +1331,19 @@ namespace delay {
 		}
 	};
 
-	/**	@brief A single-channel delay-line containing its own buffer.*/
-	template<class Sample, template<typename> class Interpolator=InterpolatorLinear>
+	/**	@brief A single-channel delay-line containing its own buffer.
+		The sample format in memory can be made more compact using @ref Storage, and the buffer's memory is taken from `Allocator`.*/
+	template<class Sample, template<typename> class Interpolator=InterpolatorLinear, template<typename> class Storage=StorageNative, class Allocator=std::allocator<Sample>>
 	class Delay : private Reader<Sample, Interpolator> {
 		using Super = Reader<Sample, Interpolator>;
-		Buffer<Sample> buffer;
+		Buffer<Sample, Storage, Allocator> buffer;
+		static constexpr int processChunk = 64;
 	public:
 		static constexpr Sample latency = Super::latency;
 
-		Delay(int capacity=0) : buffer(1 + capacity + Super::inputLength) {}
+		Delay(int capacity=0, const Allocator &allocator=Allocator()) : buffer(1 + capacity + Super::inputLength, allocator) {}
 		/// Pass in a configured interpolator
-		Delay(const Interpolator<Sample> &interp, int capacity=0) : Super(interp), buffer(1 + capacity + Super::inputLength) {}
+		Delay(const Interpolator<Sample> &interp, int capacity=0, const Allocator &allocator=Allocator()) : Super(interp), buffer(1 + capacity + Super::inputLength, allocator) {}
 		
 		void reset(Sample value=Sample()) {
 			buffer.reset(value);
@@ -638,18 +1364,90 @@ namespace delay {
 			buffer[0] = value;
 			return *this;
 		}
+
+		/** Processes a block with a constant delay, equivalent to `output[i] = delay.write(input[i]).read(delaySamples)`.
+
+		The interpolator weights are calculated once for the whole block.  If they pick out a single sample (e.g. integer delays for most interpolators), it's a straight copy from the buffer.  Otherwise the weights are applied as an FIR, on a contiguous copy of the buffer so that it can be vectorised.
+
+		The delay must be within the capacity (see constructor/`.resize()`), but `length` can be anything.  It can be processed in-place.*/
+		template<class Input, class Output>
+		void process(Input &&input, Output &&output, int length, Sample delaySamples) {
+			constexpr int inputLength = Super::inputLength;
+			int startIndex = delaySamples;
+			Sample remainder = delaySamples - startIndex;
+
+			// All our interpolators are linear, so we find their weights by interpolating impulses
+			struct Impulse {
+				int index;
+				Sample operator [](int i) const {
+					return (i == index) ? 1 : 0;
+				}
+			};
+			std::array<Sample, inputLength> weights;
+			int copyIndex = -1;
+			for (int k = 0; k < inputLength; ++k) {
+				weights[k] = Super::fractional(Impulse{k}, remainder);
+				if (weights[k] == 1 && copyIndex < 0) {
+					copyIndex = k;
+				} else if (weights[k] != 0) {
+					copyIndex = inputLength; // not a copy
+				}
+			}
+			if (copyIndex >= inputLength) copyIndex = -1;
+
+			// Each chunk is written before being read, so it can't be long enough to overwrite the history it needs
+			int maxChunk = std::min(int(processChunk), buffer.capacity() + 1 - startIndex - inputLength);
+			if (maxChunk < 1) maxChunk = 1;
+			std::array<Sample, processChunk + inputLength - 1> history;
+			for (int start = 0; start < length; start += maxChunk) {
+				int chunk = std::min(maxChunk, length - start);
+				for (int i = 0; i < chunk; ++i) {
+					buffer[i + 1] = input[start + i];
+				}
+				buffer += chunk;
+
+				// Position (relative to the head) of the first output's first interpolator input
+				int offset = 1 - chunk - startIndex;
+				if (copyIndex >= 0) {
+					for (int i = 0; i < chunk; ++i) {
+						output[start + i] = buffer[offset + i - copyIndex];
+					}
+				} else {
+					int historyOffset = offset + 1 - inputLength;
+					for (int i = 0; i < chunk + inputLength - 1; ++i) {
+						history[i] = buffer[historyOffset + i];
+					}
+					std::array<Sample, processChunk> sum;
+					for (int i = 0; i < chunk; ++i) {
+						sum[i] = 0;
+					}
+					for (int k = 0; k < inputLength; ++k) {
+						Sample w = weights[k];
+						const Sample *kHistory = history.data() + (inputLength - 1 - k);
+						for (int i = 0; i < chunk; ++i) {
+							sum[i] += w*kHistory[i];
+						}
+					}
+					for (int i = 0; i < chunk; ++i) {
+						output[start + i] = sum[i];
+					}
+				}
+			}
+		}
 	};
 
-	/**	@brief A multi-channel delay-line with its own buffer. */
-	template<class Sample, template<typename> class Interpolator=InterpolatorLinear>
+	/**	@brief A multi-channel delay-line with its own buffer.
+		If `interleaved` is enabled, the samples are stored frame-major (see `MultiBuffer`), which is usually faster for larger channel counts.  The sample format in memory can be made more compact using @ref Storage, and the buffer's memory is taken from `Allocator`.*/
+	template<class Sample, template<typename> class Interpolator=InterpolatorLinear, bool interleaved=false, template<typename> class Storage=StorageNative, class Allocator=std::allocator<Sample>>
 	class MultiDelay : private Reader<Sample, Interpolator> {
 		using Super = Reader<Sample, Interpolator>;
+		using MultiBufferType = MultiBuffer<Sample, interleaved, Storage, Allocator>;
 		int channels;
-		MultiBuffer<Sample> multiBuffer;
+		MultiBufferType multiBuffer;
 	public:
 		static constexpr Sample latency = Super::latency;
 
-		MultiDelay(int channels=0, int capacity=0) : channels(channels), multiBuffer(channels, 1 + capacity + Super::inputLength) {}
+		MultiDelay(int channels=0, int capacity=0, const Allocator &allocator=Allocator()) : channels(channels), multiBuffer(channels, 1 + capacity + Super::inputLength, allocator) {}
 
 		void reset(Sample value=Sample()) {
 			multiBuffer.reset(value);
@@ -664,7 +1462,7 @@ namespace delay {
 			static constexpr Sample latency = Super::latency;
 
 			const Super &reader;
-			typename MultiBuffer<Sample>::ConstChannel channel;
+			typename MultiBufferType::ConstChannel channel;
 			
 			Sample read(Sample delaySamples) const {
 				return reader.read(channel, delaySamples);
@@ -677,7 +1475,7 @@ namespace delay {
 		/// A multi-channel result, lazily calculating samples
 		struct DelayView {
 			Super &reader;
-			typename MultiBuffer<Sample>::ConstView view;
+			typename MultiBufferType::ConstView view;
 			Sample delaySamples;
 			
 			// Calculate samples on-the-fly
@@ -705,9 +1503,7 @@ namespace delay {
 		template<class Data>
 		MultiDelay & write(const Data &data) {
 			++multiBuffer;
-			for (int c = 0; c < channels; ++c) {
-				multiBuffer[c][0] = data[c];
-			}
+			multiBuffer.at(0).set(data);
 			return *this;
 		}
 	};
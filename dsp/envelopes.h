@@ -1,4 +1,5 @@
 #include "./common.h"
+#include "./perf.h"
 
 #ifndef SIGNALSMITH_DSP_ENVELOPES_H
 #define SIGNALSMITH_DSP_ENVELOPES_H
@@ -6,7 +7,12 @@
 #include <cmath>
 #include <random>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <iterator>
+#include <memory> // for std::allocator
+#include <type_traits>
+#include <cstdint>
 
 namespace signalsmith {
 namespace envelopes {
@@ -117,14 +123,209 @@ namespace envelopes {
 		}
 	};
 	
-	/** Variable-width rectangular sum */
-	template<typename Sample=double>
+	/** A bank of `CubicLfo`s, stepped together with each LFO in a separate (SIMD) lane.
+		\code
+			LfoBank<64> lfos(seed);
+			lfos.set(-1, 1, rate, 0.5, 0.2); // or `.setLane(lane, ...)` for a single LFO
+			lfos.process(output, length); // output[lane][i]
+		\endcode
+		Each lane behaves (statistically) the same as a `CubicLfo` with the same parameters.  The smooth part of each segment is computed for all lanes at once, and only lanes which reach the end of a segment pick a new random rate/target.
+
+		Random numbers come from a counter-based generator: a hash of each lane's key and how many values it has used.  This is cheap, and each lane's sequence depends only on its own seed - a bank with seed `s` matches lanes seeded individually with `s + lane`.
+	*/
+	template<int count>
+	class LfoBank {
+		using Lanes = std::array<float, count>;
+		Lanes ratio, ratioStep;
+		Lanes valueFrom, valueTo, valueRange;
+		Lanes targetLow, targetHigh;
+		Lanes targetRate, rateRandom, depthRandom;
+		std::array<uint32_t, count> keys, counters;
+		std::array<bool, count> freshReset;
+
+		static uint32_t hash(uint32_t x) {
+			x ^= x >> 16;
+			x *= 0x7feb352du;
+			x ^= x >> 15;
+			x *= 0x846ca68bu;
+			x ^= x >> 16;
+			return x;
+		}
+		float random(int lane) {
+			uint32_t x = hash(keys[lane] ^ (counters[lane]++*0x9e3779b9u));
+			return (x >> 8)*(1.0f/16777216); // [0, 1)
+		}
+		float randomRate(int lane) {
+			return targetRate[lane]*std::exp(rateRandom[lane]*(random(lane) - 0.5f));
+		}
+		float randomTarget(int lane, float previous) {
+			float randomOffset = depthRandom[lane]*random(lane)*(targetLow[lane] - targetHigh[lane]);
+			if (previous < (targetLow[lane] + targetHigh[lane])*0.5f) {
+				return targetHigh[lane] + randomOffset;
+			} else {
+				return targetLow[lane] - randomOffset;
+			}
+		}
+		// Starts new segments for a lane which has reached the end of one
+		void nextSegment(int lane) {
+			while (ratio[lane] >= 1) {
+				ratio[lane] -= 1;
+				ratioStep[lane] = randomRate(lane);
+				valueFrom[lane] = valueTo[lane];
+				valueTo[lane] = randomTarget(lane, valueFrom[lane]);
+				valueRange[lane] = valueTo[lane] - valueFrom[lane];
+			}
+		}
+		// Computes one output for every lane, and advances
+		SIGNALSMITH_INLINE void step(Lanes &frame) {
+			int anyEnded = 0; // not `bool`, so the reduction vectorises
+			for (int lane = 0; lane < count; ++lane) {
+				float r = ratio[lane];
+				frame[lane] = r*r*(3 - 2*r)*valueRange[lane] + valueFrom[lane];
+				r += ratioStep[lane];
+				ratio[lane] = r;
+				anyEnded |= int(r >= 1);
+			}
+			if (anyEnded) {
+				for (int lane = 0; lane < count; ++lane) {
+					if (ratio[lane] >= 1) nextSegment(lane);
+				}
+			}
+		}
+	public:
+		LfoBank() {
+			seed(std::random_device()());
+		}
+		LfoBank(long seed) {
+			this->seed(seed);
+		}
+
+		/// Seeds every lane (with `seed + lane`), and resets
+		void seed(uint32_t seed) {
+			for (int lane = 0; lane < count; ++lane) seedLane(lane, seed + uint32_t(lane));
+		}
+		/// Seeds a single lane, and resets it
+		void seedLane(int lane, uint32_t laneSeed) {
+			keys[lane] = hash(laneSeed + 0x9e3779b9u);
+			counters[lane] = 0;
+			targetLow[lane] = 0;
+			targetHigh[lane] = 1;
+			targetRate[lane] = 0;
+			rateRandom[lane] = 0.5;
+			depthRandom[lane] = 0;
+			resetLane(lane);
+		}
+
+		/// Resets every LFO, starting with random phase
+		void reset() {
+			for (int lane = 0; lane < count; ++lane) resetLane(lane);
+		}
+		/// Resets a single LFO (see `CubicLfo::reset()`)
+		void resetLane(int lane) {
+			ratio[lane] = random(lane);
+			ratioStep[lane] = randomRate(lane);
+			if (random(lane) < 0.5) {
+				valueFrom[lane] = targetLow[lane];
+				valueTo[lane] = targetHigh[lane];
+			} else {
+				valueFrom[lane] = targetHigh[lane];
+				valueTo[lane] = targetLow[lane];
+			}
+			valueRange[lane] = valueTo[lane] - valueFrom[lane];
+			freshReset[lane] = true;
+		}
+
+		/// Smoothly updates the parameters for every LFO
+		void set(float low, float high, float rate, float rateVariation=0, float depthVariation=0) {
+			for (int lane = 0; lane < count; ++lane) setLane(lane, low, high, rate, rateVariation, depthVariation);
+		}
+		/// Smoothly updates the parameters for a single LFO (see `CubicLfo::set()`)
+		void setLane(int lane, float low, float high, float rate, float rateVariation=0, float depthVariation=0) {
+			rate *= 2; // We want to go up and down during this period
+			targetRate[lane] = rate;
+			targetLow[lane] = std::min(low, high);
+			targetHigh[lane] = std::max(low, high);
+			rateRandom[lane] = rateVariation;
+			depthRandom[lane] = std::min<float>(1, std::max<float>(0, depthVariation));
+
+			// If we haven't called .next() yet, don't bother being smooth.
+			if (freshReset[lane]) return resetLane(lane);
+
+			// Only update the current rate if it's outside our new random-variation range
+			float maxRandomRatio = std::exp(0.5f*rateRandom[lane]);
+			if (ratioStep[lane] > rate*maxRandomRatio || ratioStep[lane] < rate/maxRandomRatio) {
+				ratioStep[lane] = randomRate(lane);
+			}
+		}
+
+		/// Writes the next output for every LFO, to `output[lane]`
+		template<class Output>
+		void next(Output &&output) {
+			freshReset.fill(false);
+			Lanes frame;
+			step(frame);
+			for (int lane = 0; lane < count; ++lane) output[lane] = frame[lane];
+		}
+		/// Writes a block of output, to `output[lane][i]`
+		template<class Output>
+		void process(Output &&output, int length) {
+			freshReset.fill(false);
+			// Frames are computed into a small tile, so each lane's output is written contiguously
+			constexpr int tileLength = 16;
+			Lanes tile[tileLength];
+			for (int start = 0; start < length; start += tileLength) {
+				int tileEnd = std::min(length - start, tileLength);
+				for (int i = 0; i < tileEnd; ++i) step(tile[i]);
+				for (int lane = 0; lane < count; ++lane) {
+					auto &&laneOutput = output[lane];
+					for (int i = 0; i < tileEnd; ++i) laneOutput[start + i] = tile[i][lane];
+				}
+			}
+		}
+	};
+	
+	/** Compensated (Kahan-Babuška) running sum, for use as the `Sum` type of `BoxSum`/`BoxFilter`/`BoxStackFilter`.
+		This keeps very long windows (e.g. millions of samples for loudness metering) accurate without needing a wider type.
+	*/
+	template<typename Sample>
+	struct CompensatedSum {
+		Sample sum = 0, error = 0;
+
+		CompensatedSum(Sample value=0) : sum(value) {}
+
+		CompensatedSum & operator +=(Sample value) {
+			Sample newSum = sum + value;
+			// Exact rounding error, whichever is larger
+			Sample sumPart = newSum - value, valuePart = newSum - sumPart;
+			error += (sum - sumPart) + (value - valuePart);
+			sum = newSum;
+			return *this;
+		}
+		CompensatedSum & operator +=(const CompensatedSum &other) {
+			*this += other.sum;
+			error += other.error;
+			return *this;
+		}
+		Sample operator -(const CompensatedSum &other) const {
+			return (sum - other.sum) + (error - other.error);
+		}
+	};
+
+	/** Variable-width rectangular sum
+		Memory is taken from `Allocator` (e.g. `perf::ArenaAllocator`), passed as the last constructor argument.
+
+		The running sum restarts every time the buffer wraps, so errors don't accumulate forever, but within that a `float` sum can still drift for very long windows.  The `Sum` type can be wider (e.g. `double` for `float` input), an integer type for exact sums of integer/fixed-point input, or `CompensatedSum<Sample>`. */
+	template<typename Sample=double, class Allocator=std::allocator<Sample>, typename Sum=Sample>
 	class BoxSum {
+		using SumAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Sum>;
 		int bufferLength, index;
-		std::vector<Sample> buffer;
-		Sample sum = 0, wrapJump = 0;
+		std::vector<Sum, SumAllocator> buffer;
+		Sum sum = 0, wrapJump = 0;
 	public:
-		BoxSum(int maxLength) {
+		/// Type used for the final subtraction: floating-point sums use at least `double`
+		using Difference = typename std::conditional<std::is_floating_point<Sum>::value && (sizeof(Sum) < sizeof(double)), double, Sum>::type;
+
+		BoxSum(int maxLength, const Allocator &allocator=Allocator()) : buffer(allocator) {
 			resize(maxLength);
 		}
 
@@ -150,7 +351,7 @@ namespace envelopes {
 		
 		Sample read(int width) {
 			int readIndex = index - width;
-			double result = sum;
+			Difference result = sum;
 			if (readIndex < 0) {
 				result += wrapJump;
 				readIndex += bufferLength;
@@ -173,14 +374,45 @@ namespace envelopes {
 			write(value);
 			return read(width);
 		}
+
+		/// Equivalent to `output[i] = readWrite(input[i], width)` for a block, but without the per-sample wrapping checks.  This can be in-place.
+		void process(const Sample *input, Sample *output, int length, int width) {
+			Sum *data = buffer.data();
+			int i = 0;
+			while (i < length) {
+				if (index + 1 == bufferLength) {
+					index = -1;
+					wrapJump = sum;
+					sum = 0;
+				}
+				// Until the next wrap, the first few samples read from before the previous wrap
+				int end = std::min(length, i + bufferLength - 1 - index);
+				int wrappedEnd = std::min(end, i + std::max(0, width - 1 - index));
+				Sum runningSum = sum;
+				for (; i < wrappedEnd; ++i) {
+					runningSum += input[i];
+					data[++index] = runningSum;
+					Difference result = runningSum;
+					result += wrapJump;
+					output[i] = result - data[index - width + bufferLength];
+				}
+				for (; i < end; ++i) {
+					runningSum += input[i];
+					data[++index] = runningSum;
+					Difference result = runningSum;
+					output[i] = result - data[index - width];
+				}
+				sum = runningSum;
+			}
+		}
 	};
 	
 	/** Rectangular moving average filter (FIR).
 		\diagram{box-filter-example.svg}
 		A filter of length 1 has order 0 (i.e. does nothing). */
-	template<typename Sample=double>
+	template<typename Sample=double, typename Sum=Sample>
 	class BoxFilter {
-		BoxSum<Sample> boxSum;
+		BoxSum<Sample, std::allocator<Sample>, Sum> boxSum;
 		int _length, _maxLength;
 		Sample multiplier;
 	public:
@@ -208,33 +440,48 @@ namespace envelopes {
 		Sample operator()(Sample v) {
 			return boxSum.readWrite(v, _length)*multiplier;
 		}
+
+		/// Processes a block, giving identical results to calling `filter(v)` for each sample.  This can be in-place.
+		void process(const Sample *input, Sample *output, int length) {
+			boxSum.process(input, output, length, _length);
+			for (int i = 0; i < length; ++i) output[i] *= multiplier;
+		}
 	};
 
+	template<typename Sample, int channels, typename Sum>
+	class MultiBoxStackFilter;
+
 	/** FIR filter made from a stack of `BoxFilter`s.
 		This filter has a non-negative impulse (monotonic step response), making it useful for smoothing positive-only values.  It provides an optimal set of box-lengths, chosen to minimise peaks in the stop-band:
 			\diagram{box-stack-long.svg,Impulse responses for various stack sizes at length N=1000}
 		Since the underlying box-averages must have integer width, the peaks are slightly higher for shorter lengths with higher numbers of layers:
 			\diagram{box-stack-short-freq.svg,Frequency responses for various stack sizes at length N=30}
 	*/
-	template<typename Sample=double>
+	template<typename Sample=double, typename Sum=Sample>
 	class BoxStackFilter {
 		struct Layer {
 			double ratio = 0, lengthError = 0;
 			int length = 0;
-			BoxFilter<Sample> filter{0};
+			BoxFilter<Sample, Sum> filter{0};
 			Layer() {}
 		};
 		int _size;
 		std::vector<Layer> layers;
 
-		template<class Iterable>
-		void setupLayers(const Iterable &ratios) {
+		// Layers are processed in turn over blocks this long, which stay in cache
+		static constexpr int chunkLength = 256;
+
+		template<typename, int, typename>
+		friend class MultiBoxStackFilter;
+
+		template<class Layers, class Iterable>
+		static void setupLayers(Layers &layers, const Iterable &ratios) {
 			layers.resize(0);
 			double sum = 0;
 			for (auto ratio : ratios) {
-				Layer layer;
+				typename Layers::value_type layer;
 				layer.ratio = ratio;
-				layers.push_back(layer);
+				layers.push_back(std::move(layer));
 				sum += ratio;
 			}
 			double factor = 1/sum;
@@ -242,6 +489,34 @@ namespace envelopes {
 				l.ratio *= factor;
 			}
 		}
+		// Splits the total order between the layers (setting `.length`)
+		template<class Layers>
+		static void setLayerLengths(Layers &layers, int size) {
+			int order = size - 1;
+			int totalOrder  = 0;
+			
+			for (auto &layer : layers) {
+				double layerOrderFractional = layer.ratio*order;
+				int layerOrder = int(layerOrderFractional);
+				layer.length = layerOrder + 1;
+				layer.lengthError = layerOrder - layerOrderFractional;
+				totalOrder += layerOrder;
+			}
+			// Round some of them up, so the total is correct - this is O(N²), but `layers.size()` is small
+			while (totalOrder < order) {
+				int minIndex = 0;
+				double minError = layers[0].lengthError;
+				for (size_t i = 1; i < layers.size(); ++i) {
+					if (layers[i].lengthError < minError) {
+						minError = layers[i].lengthError;
+						minIndex = i;
+					}
+				}
+				layers[minIndex].length++;
+				layers[minIndex].lengthError += 1;
+				totalOrder++;
+			}
+		}
 	public:
 		BoxStackFilter(int maxSize, int layers=4) {
 			resize(maxSize, layers);
@@ -295,7 +570,7 @@ namespace envelopes {
 		/// Sets the maximum (and current) impulse response length and explicit length ratios
 		template<class List>
 		auto resize(int maxSize, List ratios) -> decltype(void(std::begin(ratios)), void(std::end(ratios))) {
-			setupLayers(ratios);
+			setupLayers(layers, ratios);
 			for (auto &layer : layers) layer.filter.resize(0); // .set() will expand it later
 			_size = -1;
 			set(maxSize);
@@ -311,30 +586,7 @@ namespace envelopes {
 
 			if (_size == size) return;
 			_size = size;
-			int order = size - 1;
-			int totalOrder  = 0;
-			
-			for (auto &layer : layers) {
-				double layerOrderFractional = layer.ratio*order;
-				int layerOrder = int(layerOrderFractional);
-				layer.length = layerOrder + 1;
-				layer.lengthError = layerOrder - layerOrderFractional;
-				totalOrder += layerOrder;
-			}
-			// Round some of them up, so the total is correct - this is O(N²), but `layers.size()` is small
-			while (totalOrder < order) {
-				int minIndex = 0;
-				double minError = layers[0].lengthError;
-				for (size_t i = 1; i < layers.size(); ++i) {
-					if (layers[i].lengthError < minError) {
-						minError = layers[i].lengthError;
-						minIndex = i;
-					}
-				}
-				layers[minIndex].length++;
-				layers[minIndex].lengthError += 1;
-				totalOrder++;
-			}
+			setLayerLengths(layers, size);
 			for (auto &layer : layers) layer.filter.set(layer.length);
 		}
 
@@ -349,6 +601,181 @@ namespace envelopes {
 			}
 			return v;
 		}
+
+		/// Processes a block, giving identical results to calling `filter(v)` for each sample.  All the layers run over one cache-sized chunk before moving on to the next.  This can be in-place.
+		void process(const Sample *input, Sample *output, int length) {
+			if (layers.empty()) {
+				if (input != output) std::copy(input, input + length, output);
+				return;
+			}
+			for (int start = 0; start < length; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), length - start);
+				const Sample *chunkInput = input + start;
+				for (auto &layer : layers) {
+					layer.filter.process(chunkInput, output + start, chunk);
+					chunkInput = output + start;
+				}
+			}
+		}
+	};
+	
+	/** Multi-channel `BoxStackFilter`, for a fixed number of channels.
+		\code
+			MultiBoxStackFilter<float, 2> filter(maxSize, layers);
+			filter.set(size);
+			// input[c][i] and output[c][i]
+			filter.process(input, output, length);
+		\endcode
+		The channels are stored side-by-side, so each step of each layer vectorises across them, and all the layers run over a cache-sized chunk of frames before moving on.  Each channel gives identical results to its own `BoxStackFilter`.
+	*/
+	template<typename Sample, int channels, typename Sum=Sample>
+	class MultiBoxStackFilter {
+		using Stack = BoxStackFilter<Sample, Sum>;
+		using Difference = typename BoxSum<Sample, std::allocator<Sample>, Sum>::Difference;
+		using SumFrame = std::array<Sum, channels>;
+		static constexpr int chunkLength = 64;
+
+		// Equivalent to a `BoxFilter`, with interleaved channels
+		struct Layer {
+			double ratio = 0, lengthError = 0;
+			int length = 0, maxLength = -1;
+			Sample multiplier = 1;
+			int bufferLength = 1, index = 0;
+			std::vector<Sum> buffer;
+			SumFrame sum{}, wrapJump{};
+
+			void resize(int newMaxLength) {
+				maxLength = newMaxLength;
+				bufferLength = maxLength + 1;
+				buffer.resize(bufferLength*channels);
+				reset(Sample());
+			}
+			void reset(Sample fill) {
+				index = 0;
+				Sum running = 0;
+				for (int i = 0; i < bufferLength; ++i) {
+					for (int c = 0; c < channels; ++c) buffer[i*channels + c] = running;
+					running += fill;
+				}
+				wrapJump.fill(running);
+				sum.fill(0);
+			}
+			// Processes interleaved frames in-place, in runs between the wrapping points (as in `BoxSum::process()`)
+			void process(Sample *frames, int frameCount) {
+				Sum *data = buffer.data();
+				// Local copies, since they could otherwise alias the output
+				Sample gain = multiplier;
+				int width = length;
+				int i = 0;
+				while (i < frameCount) {
+					if (index + 1 == bufferLength) {
+						index = -1;
+						wrapJump = sum;
+						sum.fill(0);
+					}
+					int end = std::min(frameCount, i + bufferLength - 1 - index);
+					int wrappedEnd = std::min(end, i + std::max(0, width - 1 - index));
+					SumFrame running = sum, jump = wrapJump;
+					Sum *row = data + (index + 1)*channels;
+					for (; i < wrappedEnd; ++i) {
+						Sample *frame = frames + i*channels;
+						const Sum *past = row + (bufferLength - width)*channels;
+						// All loads before any stores, so the channels can be vectorised despite possible aliasing
+						std::array<Sample, channels> result;
+						for (int c = 0; c < channels; ++c) {
+							running[c] += frame[c];
+							Difference difference = running[c];
+							difference += jump[c];
+							result[c] = Sample(difference - past[c])*gain;
+						}
+						for (int c = 0; c < channels; ++c) row[c] = running[c];
+						for (int c = 0; c < channels; ++c) frame[c] = result[c];
+						row += channels;
+					}
+					for (; i < end; ++i) {
+						Sample *frame = frames + i*channels;
+						const Sum *past = row - width*channels;
+						std::array<Sample, channels> result;
+						for (int c = 0; c < channels; ++c) {
+							running[c] += frame[c];
+							Difference difference = running[c];
+							result[c] = Sample(difference - past[c])*gain;
+						}
+						for (int c = 0; c < channels; ++c) row[c] = running[c];
+						for (int c = 0; c < channels; ++c) frame[c] = result[c];
+						row += channels;
+					}
+					index = int(row - data)/channels - 1;
+					sum = running;
+				}
+			}
+		};
+		int _size = -1;
+		std::vector<Layer> layers;
+	public:
+		MultiBoxStackFilter(int maxSize, int layers=4) {
+			resize(maxSize, layers);
+		}
+
+		/// Sets size using an optimal (heuristic at larger sizes) set of length ratios
+		void resize(int maxSize, int layerCount) {
+			resize(maxSize, Stack::optimalRatios(layerCount));
+		}
+		/// Sets the maximum (and current) impulse response length and explicit length ratios
+		template<class List>
+		auto resize(int maxSize, List ratios) -> decltype(void(std::begin(ratios)), void(std::end(ratios))) {
+			Stack::setupLayers(layers, ratios);
+			for (auto &layer : layers) layer.resize(0); // .set() will expand it later
+			_size = -1;
+			set(maxSize);
+			reset();
+		}
+		void resize(int maxSize, std::initializer_list<double> ratios) {
+			resize<const std::initializer_list<double> &>(maxSize, ratios);
+		}
+
+		/// Sets the impulse response length (does not reset if `size` ≤ `maxSize`)
+		void set(int size) {
+			if (layers.size() == 0) return; // meaningless
+
+			if (_size == size) return;
+			_size = size;
+			Stack::setLayerLengths(layers, size);
+			for (auto &layer : layers) {
+				layer.multiplier = Sample(1)/layer.length;
+				if (layer.length > layer.maxLength) layer.resize(layer.length);
+			}
+		}
+
+		/// Resets the filter
+		void reset(Sample fill=Sample()) {
+			for (auto &layer : layers) layer.reset(fill);
+		}
+
+		/// Processes a single frame, from `input[c]` to `output[c]`
+		template<class Input, class Output>
+		void operator()(Input &&input, Output &&output) {
+			std::array<Sample, channels> frame;
+			for (int c = 0; c < channels; ++c) frame[c] = input[c];
+			for (auto &layer : layers) layer.process(frame.data(), 1);
+			for (int c = 0; c < channels; ++c) output[c] = frame[c];
+		}
+
+		/// Processes a block of `input[c][i]` into `output[c][i]`
+		template<class Input, class Output>
+		void process(Input &&input, Output &&output, int length) {
+			std::array<Sample, chunkLength*channels> frames;
+			for (int start = 0; start < length; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), length - start);
+				for (int i = 0; i < chunk; ++i) {
+					for (int c = 0; c < channels; ++c) frames[i*channels + c] = input[c][start + i];
+				}
+				for (auto &layer : layers) layer.process(frames.data(), chunk);
+				for (int i = 0; i < chunk; ++i) {
+					for (int c = 0; c < channels; ++c) output[c][start + i] = frames[i*channels + c];
+				}
+			}
+		}
 	};
 	
 	/** Peak-hold filter.
@@ -356,18 +783,25 @@ namespace envelopes {
 		
 		The size is variable, and can be changed instantly with `.set()`, or by using `.push()`/`.pop()` in an unbalanced way.
 
-		This has complexity O(1) every sample when the length remains constant (balanced `.push()`/`.pop()`, or using `filter(v)`), and amortised O(1) complexity otherwise.  To avoid allocations while running, it pre-allocates a vector (not a `std::deque`) which determines the maximum length.
+		This has complexity O(1) every sample when the length remains constant (balanced `.push()`/`.pop()`, or using `filter(v)`), and amortised O(1) complexity otherwise.  To avoid allocations while running, it pre-allocates a vector (not a `std::deque`) which determines the maximum length.  This memory is taken from `Allocator`, passed as the last constructor argument.
+
+		If `trough` is enabled, this holds the minimum instead (see `TroughHold`).
 	*/
-	template<typename Sample>
+	template<typename Sample, class Allocator=std::allocator<Sample>, bool trough=false>
 	class PeakHold {
-		static constexpr Sample lowest = std::numeric_limits<Sample>::lowest();
+		// "Lowest" and "maximum" are in the hold's ordering, which is reversed for a trough-hold
+		static constexpr Sample lowest = trough ? std::numeric_limits<Sample>::max() : std::numeric_limits<Sample>::lowest();
+		static Sample max(Sample a, Sample b) {
+			return trough ? std::min(a, b) : std::max(a, b);
+		}
 		int bufferMask;
-		std::vector<Sample> buffer;
+		std::vector<Sample, Allocator> buffer;
 		int backIndex = 0, middleStart = 0, workingIndex = 0, middleEnd = 0, frontIndex = 0;
 		Sample frontMax = lowest, workingMax = lowest, middleMax = lowest;
+		std::vector<Sample, Allocator> suffixMax; // scratch for `.process()`
 		
 	public:
-		PeakHold(int maxLength) {
+		PeakHold(int maxLength, const Allocator &allocator=Allocator()) : buffer(allocator), suffixMax(allocator) {
 			resize(maxLength);
 		}
 		int size() {
@@ -375,8 +809,10 @@ namespace envelopes {
 		}
 		void resize(int maxLength) {
 			int bufferLength = 1;
-			while (bufferLength < maxLength) bufferLength *= 2;
+			// `filter(v)` pushes before popping, so needs one more than the maximum length
+			while (bufferLength <= maxLength) bufferLength *= 2;
 			buffer.resize(bufferLength);
+			suffixMax.resize(bufferLength);
 			bufferMask = bufferLength - 1;
 			
 			frontIndex = backIndex + maxLength;
@@ -399,7 +835,7 @@ namespace envelopes {
 				Sample &backPrev = buffer[backIndex&bufferMask];
 				--backIndex;
 				Sample &back = buffer[backIndex&bufferMask];
-				back = preserveCurrentPeak ? backPrev : std::max(back, backPrev);
+				back = preserveCurrentPeak ? backPrev : max(back, backPrev);
 			}
 			while (size() > newSize) {
 				pop();
@@ -409,7 +845,7 @@ namespace envelopes {
 		void push(Sample v) {
 			buffer[frontIndex&bufferMask] = v;
 			++frontIndex;
-			frontMax = std::max(frontMax, v);
+			frontMax = max(frontMax, v);
 		}
 		void pop() {
 			if (backIndex == middleStart) {
@@ -439,11 +875,11 @@ namespace envelopes {
 
 					// Since the front was not completely consumed, we re-calculate the front's maximum
 					for (int i = middleEnd; i != frontIndex; ++i) {
-						frontMax = std::max(frontMax, buffer[i&bufferMask]);
+						frontMax = max(frontMax, buffer[i&bufferMask]);
 					}
 					// The index might not start at the end of the working block - compute the last bit immediately
 					for (int i = middleEnd - 1; i != workingIndex - 1; --i) {
-						buffer[i&bufferMask] = workingMax = std::max(workingMax, buffer[i&bufferMask]);
+						buffer[i&bufferMask] = workingMax = max(workingMax, buffer[i&bufferMask]);
 					}
 				}
 
@@ -466,12 +902,12 @@ namespace envelopes {
 			++backIndex;
 			if (workingIndex != middleStart) {
 				--workingIndex;
-				buffer[workingIndex&bufferMask] = workingMax = std::max(workingMax, buffer[workingIndex&bufferMask]);
+				buffer[workingIndex&bufferMask] = workingMax = max(workingMax, buffer[workingIndex&bufferMask]);
 			}
 		}
 		Sample read() {
 			Sample backMax = buffer[backIndex&bufferMask];
-			return std::max(backMax, std::max(middleMax, frontMax));
+			return max(backMax, max(middleMax, frontMax));
 		}
 		
 		// For simple use as a constant-length filter
@@ -480,8 +916,363 @@ namespace envelopes {
 			pop();
 			return read();
 		}
+
+		/** Processes a block at a constant length, giving identical results to calling `filter(v)` for each sample.  Input and output must not overlap.
+
+		For blocks at least as long as `.size()`, this uses the van Herk/Gil-Werman algorithm.  The input is split into chunks of that length.  A running maximum from the start of each chunk (the prefix `g`) is written to the output, and a running maximum to the end of the previous chunk (the suffix `h`) is written to a scratch array.  Each window spans one suffix and one prefix, so the result is `max(h[i], g[i + size - 1])`, which is a contiguous loop the compiler can vectorise.  Afterwards, the internal state is rebuilt from the end of the input.*/
+		void process(const Sample *input, Sample *output, int length) {
+			int holdLength = size();
+			if (length < holdLength || holdLength < 2) {
+				for (int i = 0; i < length; ++i) output[i] = (*this)(input[i]);
+				return;
+			}
+
+			// The first chunk takes the rest of its window from the existing history
+			Sample prefixMax = lowest;
+			for (int i = 0; i < holdLength - 1; ++i) {
+				pop();
+				prefixMax = max(prefixMax, input[i]);
+				output[i] = max(prefixMax, read());
+			}
+			output[holdLength - 1] = max(prefixMax, input[holdLength - 1]);
+
+			Sample *h = suffixMax.data();
+			for (int start = holdLength; start < length; start += holdLength) {
+				int n = std::min(holdLength, length - start);
+				// Suffix maximums of the previous chunk, and prefix maximums of this one.  These are two independent running maximums, so they're in the same loop to overlap their latency.
+				const Sample *prevInput = input + start - holdLength, *chunkInput = input + start;
+				Sample *g = output + start;
+				Sample suffix = lowest, prefix = lowest;
+				int i = 0;
+				for (; i < n; ++i) {
+					int j = holdLength - 1 - i;
+					h[j] = suffix = max(suffix, prevInput[j]);
+					g[i] = prefix = max(prefix, chunkInput[i]);
+				}
+				for (; i < holdLength; ++i) {
+					int j = holdLength - 1 - i;
+					h[j] = suffix = max(suffix, prevInput[j]);
+				}
+				// Combine (`h[0]` isn't used): the last output of a full chunk is the whole chunk, so it's just the prefix
+				int combineLength = std::min(n, holdLength - 1);
+				const Sample *hNext = h + 1;
+				for (i = 0; i < combineLength; ++i) {
+					g[i] = max(hNext[i], g[i]);
+				}
+			}
+			int lastStart = length - holdLength;
+
+			// Restart from the last window, in the balanced state `pop()` expects: the back is ready, and the middle will be processed as the back is popped
+			const Sample *window = input + lastStart;
+			int backLength = (holdLength + 1)/2;
+			int start = frontIndex + lastStart;
+			// Older input goes before the window, so that expanding with `.set()` still works
+			int olderLength = std::min(int(buffer.size()) - holdLength, lastStart);
+			for (int i = 1; i <= olderLength; ++i) {
+				buffer[(start - i)&bufferMask] = window[-i];
+			}
+			backIndex = start;
+			middleStart = start + backLength;
+			middleEnd = workingIndex = frontIndex = start + holdLength;
+			Sample backMax = lowest;
+			for (int i = backLength - 1; i >= 0; --i) {
+				buffer[(start + i)&bufferMask] = backMax = max(backMax, window[i]);
+			}
+			middleMax = lowest;
+			for (int i = backLength; i < holdLength; ++i) {
+				buffer[(start + i)&bufferMask] = window[i];
+				middleMax = max(middleMax, window[i]);
+			}
+			frontMax = workingMax = lowest;
+		}
 	};
 	
+	/// Trough-hold (sliding minimum) filter, with the same API and complexity as `PeakHold`
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	using TroughHold = PeakHold<Sample, Allocator, true>;
+
+	/** Sliding minimum and maximum together, with a shared size.
+		\code
+			PeakTroughHold<float> hold(maxLength);
+			hold.set(length);
+			hold.process(input, peaks, troughs, blockLength);
+		\endcode
+	*/
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	class PeakTroughHold {
+		PeakHold<Sample, Allocator> peakHold;
+		TroughHold<Sample, Allocator> troughHold;
+	public:
+		PeakTroughHold(int maxLength, const Allocator &allocator=Allocator()) : peakHold(maxLength, allocator), troughHold(maxLength, allocator) {}
+		int size() {
+			return peakHold.size();
+		}
+		void resize(int maxLength) {
+			peakHold.resize(maxLength);
+			troughHold.resize(maxLength);
+		}
+		/// Resets both, so that the peak is `std::numeric_limits<Sample>::lowest()` and the trough is `::max()`
+		void reset() {
+			peakHold.reset();
+			troughHold.reset();
+		}
+		void reset(Sample fill) {
+			peakHold.reset(fill);
+			troughHold.reset(fill);
+		}
+		/// Sets the size immediately (see `PeakHold::set()`)
+		void set(int newSize, bool preserveCurrent=false) {
+			peakHold.set(newSize, preserveCurrent);
+			troughHold.set(newSize, preserveCurrent);
+		}
+
+		void push(Sample v) {
+			peakHold.push(v);
+			troughHold.push(v);
+		}
+		void pop() {
+			peakHold.pop();
+			troughHold.pop();
+		}
+		Sample readPeak() {
+			return peakHold.read();
+		}
+		Sample readTrough() {
+			return troughHold.read();
+		}
+
+		/// For use as a constant-length filter, with the results available from `.readPeak()`/`.readTrough()`
+		void operator ()(Sample v) {
+			peakHold(v);
+			troughHold(v);
+		}
+		/// Processes a block at a constant length (see `PeakHold::process()`)
+		void process(const Sample *input, Sample *peaks, Sample *troughs, int length) {
+			peakHold.process(input, peaks, length);
+			troughHold.process(input, troughs, length);
+		}
+	};
+
+	/** Sliding percentile filter (median by default).
+		\code
+			SlidingPercentile<float> median(maxLength);
+			median.set(length);
+			float m = median(v);
+			// Other percentiles, e.g. for noise-floor tracking
+			SlidingPercentile<float> floor(maxLength, 0.1);
+			floor.process(input, output, blockLength);
+		\endcode
+		Like `PeakHold`, the size is variable (using `.set()`, or `.push()`/`.pop()` in an unbalanced way), and memory for the maximum length is pre-allocated from `Allocator`.
+
+		The window is split into a lower max-heap and an upper min-heap, so the values either side of the percentile are always at the top.  Adding or removing a sample is O(log N).  When the length is constant (`filter(v)` or `.process()`), the newest sample replaces the oldest one in-place, with a single sift.
+
+		The result interpolates linearly between ranked values (the same as NumPy's default), so an even-length median is the mean of the middle two.
+	*/
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	class SlidingPercentile {
+		using IndexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<int>;
+
+		int bufferMask;
+		int back = 0, count = 0;
+		double percentile;
+		// Ring buffer of values, and where each one is in the heaps (`i` in the lower heap, `~i` in the upper)
+		std::vector<Sample, Allocator> values;
+		std::vector<int, IndexAllocator> positions;
+		// Heaps of ring-buffer indices
+		std::vector<int, IndexAllocator> lower, upper;
+		int lowerSize = 0, upperSize = 0;
+
+		// Whether `a` should be nearer the top of the heap than `b`
+		template<bool isUpper>
+		static bool before(Sample a, Sample b) {
+			return isUpper ? (a < b) : (b < a);
+		}
+		template<bool isUpper>
+		void place(int heapIndex, int slot) {
+			(isUpper ? upper : lower)[heapIndex] = slot;
+			positions[slot] = isUpper ? ~heapIndex : heapIndex;
+		}
+		template<bool isUpper>
+		void siftUp(int i) {
+			const auto &heap = isUpper ? upper : lower;
+			int slot = heap[i];
+			Sample v = values[slot];
+			while (i > 0) {
+				int parent = (i - 1)/2;
+				if (!before<isUpper>(v, values[heap[parent]])) break;
+				place<isUpper>(i, heap[parent]);
+				i = parent;
+			}
+			place<isUpper>(i, slot);
+		}
+		template<bool isUpper>
+		void siftDown(int i) {
+			const auto &heap = isUpper ? upper : lower;
+			int heapSize = isUpper ? upperSize : lowerSize;
+			int slot = heap[i];
+			Sample v = values[slot];
+			while (true) {
+				int child = 2*i + 1;
+				if (child >= heapSize) break;
+				if (child + 1 < heapSize && before<isUpper>(values[heap[child + 1]], values[heap[child]])) ++child;
+				if (!before<isUpper>(values[heap[child]], v)) break;
+				place<isUpper>(i, heap[child]);
+				i = child;
+			}
+			place<isUpper>(i, slot);
+		}
+		// After the value at `i` has changed
+		template<bool isUpper>
+		void sift(int i) {
+			const auto &heap = isUpper ? upper : lower;
+			if (i > 0 && before<isUpper>(values[heap[i]], values[heap[(i - 1)/2]])) {
+				siftUp<isUpper>(i);
+			} else {
+				siftDown<isUpper>(i);
+			}
+		}
+		template<bool isUpper>
+		void insert(int slot) {
+			int &heapSize = isUpper ? upperSize : lowerSize;
+			place<isUpper>(heapSize, slot);
+			siftUp<isUpper>(heapSize++);
+		}
+		template<bool isUpper>
+		void remove(int i) {
+			const auto &heap = isUpper ? upper : lower;
+			int &heapSize = isUpper ? upperSize : lowerSize;
+			--heapSize;
+			if (i != heapSize) {
+				place<isUpper>(i, heap[heapSize]);
+				sift<isUpper>(i);
+			}
+		}
+		template<bool isUpper>
+		int removeTop() {
+			int top = (isUpper ? upper : lower)[0];
+			remove<isUpper>(0);
+			return top;
+		}
+
+		// Inserts a value which is already in the ring buffer
+		void add(int slot) {
+			if (lowerSize > 0 && values[lower[0]] < values[slot]) {
+				insert<true>(slot);
+			} else {
+				insert<false>(slot);
+			}
+			++count;
+			rebalance();
+		}
+		void rebalance() {
+			int target = (count > 0) ? int(percentile*(count - 1)) + 1 : 0;
+			while (lowerSize > target) insert<true>(removeTop<false>());
+			while (lowerSize < target) insert<false>(removeTop<true>());
+		}
+	public:
+		SlidingPercentile(int maxLength, double percentile=0.5, const Allocator &allocator=Allocator()) : percentile(std::max(0.0, std::min(1.0, percentile))), values(allocator), positions(allocator), lower(allocator), upper(allocator) {
+			resize(maxLength);
+		}
+		int size() const {
+			return count;
+		}
+		/// Sets the maximum length (and the current size to match), and resets
+		void resize(int maxLength) {
+			int bufferLength = 1;
+			// `filter(v)` adds the new value before removing the old one
+			while (bufferLength <= maxLength) bufferLength *= 2;
+			values.resize(bufferLength);
+			positions.resize(bufferLength);
+			bufferMask = bufferLength - 1;
+			lower.resize(maxLength + 1);
+			upper.resize(maxLength + 1);
+			count = maxLength;
+			reset();
+		}
+		/// Fills the history with a constant value, keeping the current size
+		void reset(Sample fill=Sample()) {
+			int prevSize = count;
+			values.assign(values.size(), fill);
+			back = count = lowerSize = upperSize = 0;
+			set(prevSize);
+		}
+		/** Sets the size immediately.
+		Must be `0 <= newSize <= maxLength` (see constructor and `.resize()`).  Expanding re-includes older values, as with `PeakHold`. */
+		void set(int newSize) {
+			while (count < newSize) {
+				back = (back - 1)&bufferMask;
+				add(back);
+			}
+			while (count > newSize) pop();
+		}
+		/// Sets the percentile, from 0 (minimum) to 1 (maximum)
+		void setPercentile(double newPercentile) {
+			percentile = std::max(0.0, std::min(1.0, newPercentile));
+			rebalance();
+		}
+
+		void push(Sample v) {
+			int slot = (back + count)&bufferMask;
+			values[slot] = v;
+			add(slot);
+		}
+		void pop() {
+			if (count == 0) return;
+			int position = positions[back];
+			if (position >= 0) {
+				remove<false>(position);
+			} else {
+				remove<true>(~position);
+			}
+			back = (back + 1)&bufferMask;
+			--count;
+			rebalance();
+		}
+		Sample read() const {
+			if (count == 0) return Sample();
+			double rank = percentile*(count - 1);
+			double fraction = rank - int(rank);
+			Sample lowerValue = values[lower[0]];
+			if (fraction <= 0 || upperSize == 0) return lowerValue;
+			Sample upperValue = values[upper[0]];
+			return lowerValue + Sample((upperValue - lowerValue)*fraction);
+		}
+
+		// For simple use as a constant-length filter
+		Sample operator ()(Sample v) {
+			if (count == 0) {
+				push(v);
+				pop();
+				return read();
+			}
+			// Replace the oldest value in-place
+			int slot = (back + count)&bufferMask;
+			values[slot] = v;
+			int position = positions[back];
+			back = (back + 1)&bufferMask;
+			if (position >= 0) {
+				place<false>(position, slot);
+				sift<false>(position);
+			} else {
+				place<true>(~position, slot);
+				sift<true>(~position);
+			}
+			// Only the new value can be on the wrong side, so a single swap fixes the order
+			if (upperSize > 0 && values[upper[0]] < values[lower[0]]) {
+				int lowerTop = lower[0], upperTop = upper[0];
+				place<false>(0, upperTop);
+				place<true>(0, lowerTop);
+				siftDown<false>(0);
+				siftDown<true>(0);
+			}
+			return read();
+		}
+		/// Processes a block at a constant length, giving identical results to calling `filter(v)` for each sample.
+		void process(const Sample *input, Sample *output, int length) {
+			for (int i = 0; i < length; ++i) output[i] = (*this)(input[i]);
+		}
+	};
+
 	/** Peak-decay filter with a linear shape and fixed-time return to constant value.
 		\diagram{peak-decay-linear.svg}
 		This is equivalent to a `BoxFilter` which resets itself whenever the output would be less than the input.
@@ -518,6 +1309,402 @@ namespace envelopes {
 		}
 	};
 
+	template<typename Sample, int channels>
+	class MultiPeakDecayLinear;
+
+	/** Multi-channel peak-hold, with a fixed number of channels and an extra "linked" output (the peak across all channels).
+		\code
+			MultiPeakHold<float, 2> peakHold(maxLength);
+			peakHold.set(holdLength);
+			// Per-channel output[c][i], and linked[i]
+			peakHold.process(input, output, linked, length);
+			// Only the linked output
+			peakHold.processLinked(input, linked, length);
+		\endcode
+		Each channel (and the linked output) gives the same result as a `PeakHold` of the same length, but the channels are stored side-by-side so each step vectorises across them.
+		
+		It splits the input into chunks of the hold length: each output is the maximum of a running maximum for the current chunk, and a stored suffix maximum from the previous one (as in `PeakHold::process()`).  The only branch is at the end of each chunk, when the suffix maximums are calculated.
+
+		The length can't be changed by pushing/popping, and changing it with `.set()` holds each channel's current peak for the new length (like `PeakHold::set(length, true)`).
+	*/
+	template<typename Sample, int channels, class Allocator=std::allocator<Sample>>
+	class MultiPeakHold {
+		static constexpr Sample lowest = std::numeric_limits<Sample>::lowest();
+		static constexpr int lanes = channels + 1;
+		using Frame = std::array<Sample, lanes>;
+
+		int maxLength = 1, length = 1, index = 0;
+		// Rows of `lanes` values: raw input for the current chunk (before `index`), suffix maximums of the previous chunk (from `index`), and one extra row of `lowest`
+		std::vector<Sample, Allocator> buffer;
+		Frame chunkMax, peaks;
+
+		template<typename, int>
+		friend class MultiPeakDecayLinear;
+
+		void fillHistory(const Frame &values) {
+			for (int i = 0; i < length; ++i) {
+				for (int c = 0; c < lanes; ++c) buffer[i*lanes + c] = values[c];
+			}
+			for (int c = 0; c < lanes; ++c) buffer[length*lanes + c] = lowest;
+			chunkMax.fill(lowest);
+			index = 0;
+			peaks = values;
+		}
+
+		// The extra lane is the maximum across channels
+		SIGNALSMITH_INLINE static void link(Frame &frame) {
+			Sample linked = lowest;
+			for (int c = 0; c < channels; ++c) linked = std::max(linked, frame[c]);
+			frame[channels] = linked;
+		}
+		SIGNALSMITH_INLINE void step(const Frame &frame) {
+			Sample *raw = buffer.data() + index*lanes;
+			const Sample *suffix = raw + lanes;
+			for (int c = 0; c < lanes; ++c) {
+				chunkMax[c] = std::max(chunkMax[c], frame[c]);
+				peaks[c] = std::max(chunkMax[c], suffix[c]);
+				raw[c] = frame[c];
+			}
+			if (++index == length) endChunk();
+		}
+		// Processes frames in runs up to the end of each chunk, keeping the running maximums in locals.  `readFn(i, frame)` fills in the channels for each input frame, and `peakFn(i, frame, peaks)` receives the result.
+		template<class ReadFn, class PeakFn>
+		SIGNALSMITH_INLINE void processRuns(int blockLength, ReadFn &&readFn, PeakFn &&peakFn) {
+			Frame frame, runMax = chunkMax, runPeaks = peaks;
+			int i = 0;
+			while (i < blockLength) {
+				int runLength = std::min(blockLength - i, length - index);
+				Sample *raw = buffer.data() + index*lanes;
+				for (int end = i + runLength; i < end; ++i) {
+					readFn(i, frame);
+					link(frame);
+					for (int c = 0; c < lanes; ++c) {
+						runMax[c] = std::max(runMax[c], frame[c]);
+						runPeaks[c] = std::max(runMax[c], raw[lanes + c]);
+						raw[c] = frame[c];
+					}
+					peakFn(i, frame, runPeaks);
+					raw += lanes;
+				}
+				index += runLength;
+				if (index == length) {
+					endChunk();
+					runMax.fill(lowest);
+				}
+			}
+			chunkMax = runMax;
+			peaks = runPeaks;
+		}
+		void endChunk() {
+			Frame suffixMax;
+			suffixMax.fill(lowest);
+			for (int i = length - 1; i >= 0; --i) {
+				Sample *row = buffer.data() + i*lanes;
+				for (int c = 0; c < lanes; ++c) {
+					row[c] = suffixMax[c] = std::max(suffixMax[c], row[c]);
+				}
+			}
+			chunkMax.fill(lowest);
+			index = 0;
+		}
+	public:
+		MultiPeakHold(int maxLength, const Allocator &allocator=Allocator()) : buffer(allocator) {
+			resize(maxLength);
+		}
+		int size() const {
+			return length;
+		}
+		/// Sets the maximum length (and the current length to match), and resets
+		void resize(int maxLength) {
+			this->maxLength = length = std::max(maxLength, 1);
+			buffer.resize((this->maxLength + 1)*lanes);
+			reset();
+		}
+		void reset(Sample fill=lowest) {
+			Frame values;
+			values.fill(fill);
+			fillHistory(values);
+		}
+		/// Sets the length, which must be `1 <= newLength <= maxLength`.
+		void set(int newLength) {
+			newLength = std::max(1, std::min(newLength, maxLength));
+			if (newLength == length) return;
+			length = newLength;
+			fillHistory(peaks);
+		}
+
+		/// Most recent output for a channel
+		Sample read(int channel) const {
+			return peaks[channel];
+		}
+		/// Most recent linked output (peak across all channels)
+		Sample readLinked() const {
+			return peaks[channels];
+		}
+
+		/// Adds a new multi-channel frame (`input[c]`), returning the linked output.  Per-channel outputs are available from `.read(c)`.
+		template<class Input>
+		Sample operator()(Input &&input) {
+			Frame frame;
+			for (int c = 0; c < channels; ++c) frame[c] = input[c];
+			link(frame);
+			step(frame);
+			return peaks[channels];
+		}
+
+		/// Processes a block of `input[c][i]`, writing per-channel `output[c][i]` and the linked `linked[i]`
+		template<class Input, class Output, class Linked>
+		void process(Input &&input, Output &&output, Linked &&linked, int blockLength) {
+			processRuns(blockLength, [&](int i, Frame &frame) {
+				for (int c = 0; c < channels; ++c) frame[c] = input[c][i];
+			}, [&](int i, const Frame &, const Frame &peaks) {
+				for (int c = 0; c < channels; ++c) output[c][i] = peaks[c];
+				linked[i] = peaks[channels];
+			});
+		}
+		/// Processes a block of `input[c][i]`, writing only the linked output `linked[i]`
+		template<class Input, class Linked>
+		void processLinked(Input &&input, Linked &&linked, int blockLength) {
+			processRuns(blockLength, [&](int i, Frame &frame) {
+				for (int c = 0; c < channels; ++c) frame[c] = input[c][i];
+			}, [&](int i, const Frame &, const Frame &peaks) {
+				linked[i] = peaks[channels];
+			});
+		}
+	};
+
+	/** Multi-channel `PeakDecayLinear`, with a linked output.
+		\code
+			MultiPeakDecayLinear<float, 2> peakDecay(maxLength);
+			peakDecay.set(decayLength);
+			peakDecay.process(input, output, linked, length);
+		\endcode
+		Each channel gives the same result as its own `PeakDecayLinear`.  The linked output is a `PeakDecayLinear` of the maximum across channels, which is what a linked limiter needs (and which is not the same as the maximum of the per-channel decays).
+		
+		This is built on `MultiPeakHold`, so changing the length holds the current peaks for the new length.
+	*/
+	template<typename Sample, int channels>
+	class MultiPeakDecayLinear {
+		static constexpr Sample lowest = std::numeric_limits<Sample>::lowest();
+		static constexpr int lanes = channels + 1;
+		using Hold = MultiPeakHold<Sample, channels>;
+		using Frame = typename Hold::Frame;
+
+		Hold peakHold;
+		Frame values;
+		Sample stepMultiplier = 1;
+
+		SIGNALSMITH_INLINE void step(const Frame &frame) {
+			Frame prevPeaks = peakHold.peaks;
+			peakHold.step(frame);
+			for (int c = 0; c < lanes; ++c) {
+				values[c] = std::max<Sample>(frame[c], values[c] + (frame[c] - prevPeaks[c])*stepMultiplier);
+			}
+		}
+		template<class Input, class OutputFn>
+		SIGNALSMITH_INLINE void processRuns(int blockLength, Input &input, OutputFn &&outputFn) {
+			Frame prevPeaks = peakHold.peaks, runValues = values;
+			Sample multiplier = stepMultiplier;
+			peakHold.processRuns(blockLength, [&](int i, Frame &frame) {
+				for (int c = 0; c < channels; ++c) frame[c] = input[c][i];
+			}, [&](int i, const Frame &frame, const Frame &peaks) {
+				for (int c = 0; c < lanes; ++c) {
+					runValues[c] = std::max<Sample>(frame[c], runValues[c] + (frame[c] - prevPeaks[c])*multiplier);
+				}
+				prevPeaks = peaks;
+				outputFn(i, runValues);
+			});
+			values = runValues;
+		}
+	public:
+		MultiPeakDecayLinear(int maxLength) : peakHold(maxLength) {
+			values.fill(lowest);
+			set(maxLength);
+		}
+		void resize(int maxLength) {
+			peakHold.resize(maxLength);
+			reset();
+		}
+		void set(double length) {
+			peakHold.set(std::ceil(length));
+			// Overshoot slightly but don't exceed 1
+			stepMultiplier = Sample(1.0001)/std::max(1.0001, length);
+		}
+		void reset(Sample start=lowest) {
+			peakHold.reset(start);
+			set(peakHold.size());
+			values.fill(start);
+		}
+
+		/// Most recent output for a channel
+		Sample read(int channel) const {
+			return values[channel];
+		}
+		/// Most recent linked output
+		Sample readLinked() const {
+			return values[channels];
+		}
+
+		/// Adds a new multi-channel frame (`input[c]`), returning the linked output.  Per-channel outputs are available from `.read(c)`.
+		template<class Input>
+		Sample operator()(Input &&input) {
+			Frame frame;
+			for (int c = 0; c < channels; ++c) frame[c] = input[c];
+			Hold::link(frame);
+			step(frame);
+			return values[channels];
+		}
+
+		/// Processes a block of `input[c][i]`, writing per-channel `output[c][i]` and the linked `linked[i]`
+		template<class Input, class Output, class Linked>
+		void process(Input &&input, Output &&output, Linked &&linked, int blockLength) {
+			processRuns(blockLength, input, [&](int i, const Frame &values) {
+				for (int c = 0; c < channels; ++c) output[c][i] = values[c];
+				linked[i] = values[channels];
+			});
+		}
+		/// Processes a block of `input[c][i]`, writing only the linked output `linked[i]`
+		template<class Input, class Linked>
+		void processLinked(Input &&input, Linked &&linked, int blockLength) {
+			processRuns(blockLength, input, [&](int i, const Frame &values) {
+				linked[i] = values[channels];
+			});
+		}
+	};
+
+	/** Linked multi-channel dynamics detector (e.g. a look-ahead limiter's sidechain), producing a gain for each frame.
+		\code
+			DynamicsDetector<float, 2> detector(maxLookahead, maxHold, maxRelease);
+			detector.setCurve(-1, 20, 6); // threshold (dB), ratio, knee width (dB)
+			detector.set(lookahead, hold, release);
+			detector.process(input, gain, length); // input[c][i], gain[i]
+			// apply `gain` to the input, delayed by `.latency()`
+		\endcode
+		This is equivalent to the following per-sample chain, on the loudest channel's absolute value:
+		\code
+			Sample reductionDb = gainComputer(level);
+			Sample held = PeakHold(lookahead + 1 + hold)(reductionDb);
+			Sample released = PeakDecayLinear(release)(held);
+			Sample smoothed = BoxStackFilter(lookahead + 1)(released);
+			gain = dB-to-gain(-smoothed);
+		\endcode
+		The peak-hold and box-stack are the same length (plus any extra hold), so the full reduction for a peak is reached after `lookahead` samples, when the delayed peak arrives.  Since the gain computer is monotonic, the peak-hold runs on the amplitude, and the gain computer (with its `log()`) is skipped for anything below the knee.
+
+		Everything runs in blocks, using the block methods of `PeakHold` and `BoxStackFilter`.  The working buffers are allocated up front, so processing doesn't allocate.
+	*/
+	template<typename Sample, int channels>
+	class DynamicsDetector {
+		static constexpr int chunkLength = 4096;
+
+		PeakHold<Sample> levelHold, releaseHold;
+		BoxStackFilter<Sample> smoother;
+		Sample releaseValue = 0, releaseMultiplier = 1;
+		std::vector<Sample> levels, reductions;
+		int _lookahead = 0;
+
+		// Gain computer, in dB
+		Sample thresholdDb = 0, kneeDb = 0, slope = 1;
+		Sample kneeStart = 1; // amplitude below which there's no reduction
+
+		static constexpr Sample dbPerLog = Sample(8.6858896380650365); // 20/ln(10)
+
+		SIGNALSMITH_INLINE Sample reductionDb(Sample amplitude) const {
+			Sample overDb = dbPerLog*std::log(amplitude) - thresholdDb;
+			Sample halfKnee = kneeDb*Sample(0.5);
+			if (overDb >= halfKnee) return slope*overDb;
+			if (overDb <= -halfKnee) return 0;
+			Sample kneeOverDb = overDb + halfKnee;
+			return slope*kneeOverDb*kneeOverDb/(2*kneeDb);
+		}
+	public:
+		DynamicsDetector(int maxLookahead, int maxHold=0, int maxRelease=1) : levelHold(0), releaseHold(0), smoother(1, 3), levels(chunkLength), reductions(chunkLength) {
+			resize(maxLookahead, maxHold, maxRelease);
+		}
+
+		/// Allocates for the maximum lengths, and resets
+		void resize(int maxLookahead, int maxHold, int maxRelease) {
+			levelHold.resize(maxLookahead + 1 + maxHold);
+			releaseHold.resize(std::max(maxRelease, 1));
+			smoother.resize(maxLookahead + 1, 3);
+			set(maxLookahead, maxHold, maxRelease);
+			reset();
+		}
+		/// Sets the look-ahead (which is also the attack and latency), the extra hold time, and the (linear-in-dB) release time - all in samples
+		void set(int lookahead, int hold=0, double release=1) {
+			_lookahead = lookahead;
+			levelHold.set(lookahead + 1 + hold);
+			release = std::max(release, 1.0);
+			releaseHold.set(int(std::ceil(release)));
+			// Same as `PeakDecayLinear`
+			releaseMultiplier = Sample(1.0001)/std::max(1.0001, release);
+			smoother.set(lookahead + 1);
+		}
+		/** Sets the gain curve.  Above the threshold, the output level rises by `1/ratio` dB per dB (so `ratio=INFINITY` is a limiter).
+
+		The knee is a quadratic section centred on the threshold, `kneeDb` wide. */
+		void setCurve(double thresholdDb, double ratio, double kneeDb=0) {
+			this->thresholdDb = Sample(thresholdDb);
+			this->kneeDb = Sample(std::max(kneeDb, 0.0));
+			slope = Sample(1 - 1/std::max(ratio, 1.0));
+			kneeStart = Sample(std::pow(10, (thresholdDb - this->kneeDb*0.5)/20));
+		}
+
+		/// The delay to apply to the audio, so that the gain-reduction arrives with the peaks which caused it
+		int latency() const {
+			return _lookahead;
+		}
+
+		void reset() {
+			levelHold.reset(0);
+			releaseHold.reset(0);
+			releaseValue = 0;
+			smoother.reset(0);
+		}
+
+		/// Processes a block of `input[c][i]`, writing the (linear) gain to `gain[i]`
+		template<class Input, class Gain>
+		void process(Input &&input, Gain &&gain, int length) {
+			for (int start = 0; start < length; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), length - start);
+				Sample *level = levels.data(), *reduction = reductions.data();
+
+				// Linked level: maximum absolute value across channels
+				for (int i = 0; i < chunk; ++i) level[i] = 0;
+				for (int c = 0; c < channels; ++c) {
+					auto &&channel = input[c];
+					for (int i = 0; i < chunk; ++i) {
+						level[i] = std::max(level[i], std::abs(Sample(channel[start + i])));
+					}
+				}
+
+				// Look-ahead hold, then the gain computer
+				levelHold.process(level, reduction, chunk);
+				for (int i = 0; i < chunk; ++i) {
+					Sample amplitude = reduction[i];
+					reduction[i] = (amplitude > kneeStart) ? reductionDb(amplitude) : 0;
+				}
+
+				// Linear release (as `PeakDecayLinear`), which needs the held peak from before each sample
+				Sample *peaks = level;
+				Sample prevPeak = releaseHold.read();
+				releaseHold.process(reduction, peaks, chunk);
+				Sample value = releaseValue, multiplier = releaseMultiplier;
+				for (int i = 0; i < chunk; ++i) {
+					Sample v = reduction[i];
+					reduction[i] = value = std::max<Sample>(v, value + (v - prevPeak)*multiplier);
+					prevPeak = peaks[i];
+				}
+				releaseValue = value;
+
+				smoother.process(reduction, reduction, chunk);
+				for (int i = 0; i < chunk; ++i) {
+					Sample r = reduction[i];
+					gain[start + i] = (r > 0) ? std::exp(r*(-1/dbPerLog)) : Sample(1);
+				}
+			}
+		}
+	};
+
 /** @} */
 }} // signalsmith::envelopes::
 #endif // include guard
@@ -0,0 +1,183 @@
+#include "./common.h"
+
+#ifndef SIGNALSMITH_DSP_FDN_H
+#define SIGNALSMITH_DSP_FDN_H
+
+#include "./delay.h"
+#include "./mix.h"
+#include "./filters.h"
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace signalsmith {
+namespace delay {
+	/**	@addtogroup Delay
+		@{
+		@file
+	*/
+
+	/**	@brief A feedback delay network (FDN), with stereo input/output.
+
+		Each delay-line has an integer length, a per-line filter (`BiquadStatic` by default, neutral until configured), and a gain set by `.setDecay()`.  The delay outputs are filtered, mixed with an orthogonal `Matrix` (see @ref Matrices), and fed back along with the input.
+
+		The stereo input/output is spread across the channels using `mix::StereoMultiMixer`, so `channels` must be even.
+
+		Processing is done in chunks no longer than the shortest delay, so that each chunk's delay outputs are all known before any new input is written.  Each line is then read (as a `MultiBuffer` block copy), filtered with `Filter::process(data, length)`, scaled and mixed to/from stereo as contiguous per-line loops.  Only the feedback `Matrix` is applied frame-by-frame, since it's a generic `.inPlace()` operation.
+		\code
+			signalsmith::delay::FeedbackDelayNetwork<float, 8> fdn;
+			fdn.setDelays(std::array<int, 8>{1031, 1327, 1523, 1871, 2053, 2311, 2647, 2909});
+			fdn.setDecay(3*sampleRate);
+			for (int c = 0; c < 8; ++c) fdn.filter(c).highShelfDb(4000/sampleRate, -3);
+			fdn.process(inputBuffers, outputBuffers, blockLength);
+		\endcode
+	*/
+	template<typename Sample, int channels, class Matrix=::signalsmith::mix::Householder<Sample, channels>, class Filter=::signalsmith::filters::BiquadStatic<Sample>>
+	class FeedbackDelayNetwork {
+		static_assert(channels > 0 && channels%2 == 0, "FeedbackDelayNetwork must have a positive even number of channels");
+		static constexpr int maxChunk = 256;
+
+		MultiBuffer<Sample> buffer;
+		std::array<int, channels> delays;
+		std::array<Sample, channels> gains;
+		std::array<Filter, channels> filters;
+		Matrix matrix;
+		// Per-line coefficients of the `StereoMultiMixer` (which is linear), so the stereo mixing can be done one line at a time
+		std::array<std::array<Sample, 2>, channels> stereoToLine, lineToStereo;
+		int minDelay = 1;
+		std::vector<Sample> chunk; // channel-major, `maxChunk` per channel
+		std::vector<Sample> stereoChunk; // `maxChunk` per channel
+	public:
+		FeedbackDelayNetwork() : chunk(channels*maxChunk), stereoChunk(2*maxChunk) {
+			delays.fill(1);
+			gains.fill(1);
+			buffer.resize(channels, 1);
+
+			::signalsmith::mix::StereoMultiMixer<Sample, channels> mixer;
+			const Sample outputScale = mixer.scalingFactor2();
+			for (int s = 0; s < 2; ++s) {
+				std::array<Sample, 2> stereo{{Sample(s == 0), Sample(s == 1)}};
+				std::array<Sample, channels> multi;
+				mixer.stereoToMulti(stereo, multi);
+				for (int c = 0; c < channels; ++c) stereoToLine[c][s] = multi[c];
+			}
+			for (int c = 0; c < channels; ++c) {
+				std::array<Sample, channels> multi;
+				multi.fill(0);
+				multi[c] = 1;
+				std::array<Sample, 2> stereo;
+				mixer.multiToStereo(multi, stereo);
+				lineToStereo[c][0] = stereo[0]*outputScale;
+				lineToStereo[c][1] = stereo[1]*outputScale;
+			}
+		}
+		template<class Delays>
+		FeedbackDelayNetwork(const Delays &delays) : FeedbackDelayNetwork() {
+			setDelays(delays);
+		}
+
+		/// Sets the (integer) delay lengths, which must be at least 1.  This resizes (and clears) the internal buffer.
+		template<class Delays>
+		void setDelays(const Delays &newDelays) {
+			int maxDelay = 1;
+			minDelay = newDelays[0];
+			for (int c = 0; c < channels; ++c) {
+				delays[c] = std::max(1, int(newDelays[c]));
+				maxDelay = std::max(maxDelay, delays[c]);
+				minDelay = std::min(minDelay, delays[c]);
+			}
+			minDelay = std::max(minDelay, 1);
+			buffer.resize(channels, maxDelay + 1);
+		}
+		int delay(int channel) const {
+			return delays[channel];
+		}
+
+		/// Sets the per-line gains so that the loop decays by 60dB over `rt60Samples` (ignoring the filters)
+		void setDecay(double rt60Samples) {
+			for (int c = 0; c < channels; ++c) {
+				gains[c] = std::pow(10, -3*delays[c]/rt60Samples);
+			}
+		}
+		/// Sets a constant feedback gain for all lines
+		void setFeedback(Sample gain) {
+			gains.fill(gain);
+		}
+
+		/// The filter for a particular delay-line, for configuring
+		Filter & filter(int channel) {
+			return filters[channel];
+		}
+		const Filter & filter(int channel) const {
+			return filters[channel];
+		}
+
+		void reset() {
+			buffer.reset();
+			for (auto &f : filters) f.reset();
+		}
+
+		/// Processes stereo input into stereo output (`input[c][i]` / `output[c][i]`).  They may be the same buffers.
+		template<class Input, class Output>
+		void process(Input &&input, Output &&output, int length) {
+			int maxStep = std::min(minDelay, maxChunk);
+			Sample *outLeft = stereoChunk.data(), *outRight = stereoChunk.data() + maxChunk;
+
+			for (int start = 0; start < length; start += maxStep) {
+				int n = std::min(maxStep, length - start);
+				for (int i = 0; i < n; ++i) {
+					outLeft[i] = outRight[i] = 0;
+				}
+
+				// Read, filter and scale each delay output, and mix it into the stereo output
+				for (int c = 0; c < channels; ++c) {
+					Sample *line = chunk.data() + c*maxChunk;
+					(buffer[c] + (1 - delays[c])).read(n, line);
+					filters[c].process(line, n);
+					Sample gain = gains[c];
+					for (int i = 0; i < n; ++i) {
+						line[i] *= gain;
+					}
+					Sample toLeft = lineToStereo[c][0], toRight = lineToStereo[c][1];
+					for (int i = 0; i < n; ++i) {
+						outLeft[i] += line[i]*toLeft;
+						outRight[i] += line[i]*toRight;
+					}
+				}
+
+				// Feedback matrix
+				for (int i = 0; i < n; ++i) {
+					std::array<Sample, channels> frame;
+					for (int c = 0; c < channels; ++c) frame[c] = chunk[c*maxChunk + i];
+					matrix.inPlace(frame);
+					for (int c = 0; c < channels; ++c) chunk[c*maxChunk + i] = frame[c];
+				}
+
+				// Add the input (before writing the output, in case they're the same buffers), and write back into the delay-lines
+				auto &&inLeft = input[0];
+				auto &&inRight = input[1];
+				for (int c = 0; c < channels; ++c) {
+					Sample *line = chunk.data() + c*maxChunk;
+					Sample fromLeft = stereoToLine[c][0], fromRight = stereoToLine[c][1];
+					for (int i = 0; i < n; ++i) {
+						line[i] += Sample(inLeft[start + i])*fromLeft + Sample(inRight[start + i])*fromRight;
+					}
+					(buffer[c] + 1).write(line, n);
+				}
+				buffer += n;
+
+				auto &&left = output[0];
+				auto &&right = output[1];
+				for (int i = 0; i < n; ++i) {
+					left[start + i] = outLeft[i];
+					right[start + i] = outRight[i];
+				}
+			}
+		}
+	};
+
+/** @} */
+}} // signalsmith::delay::
+#endif // include guard
@@ -7,6 +7,9 @@
 
 #include <cmath>
 #include <complex>
+#include <array>
+#include <vector>
+#include <type_traits>
 
 namespace signalsmith {
 namespace filters {
@@ -35,18 +38,140 @@ namespace filters {
 		vicanek ///< From Martin Vicanek's [Matched Second Order Digital Filters](https://vicanek.de/articles/BiquadFits.pdf).  Falls back to `oneSided` for shelf and allpass filters.  This takes the poles from the impulse-invariant approach, and then picks the zeros to create a better match.  This means that Nyquist is not 0dB for peak/notch (or -Inf for lowpass), but it is a decent match to the analogue prototype.
 	};
 	
+	template<typename Sample, int channels, bool sharedCoefficients, bool ramping>
+	class BiquadBank;
+	template<typename Sample, bool ramping>
+	class BiquadCascade;
+	template<typename Sample>
+	class SVF;
+	template<typename Sample>
+	class BiquadBlockParallel;
+	template<typename Sample>
+	class Crossover;
+
+	namespace _biquad_impl {
+		// Coefficient-ramp state (see `BiquadStatic::rampTo()`), which is empty unless ramping is enabled
+		template<typename Sample, bool ramping>
+		struct RampState {};
+		template<typename Sample>
+		struct RampState<Sample, true> {
+			// Per-sample steps, and the exact final values
+			int rampRemaining = 0;
+			Sample stepA1 = 0, stepA2 = 0, stepB0 = 0, stepB1 = 0, stepB2 = 0;
+			Sample targetA1 = 0, targetA2 = 0, targetB0 = 1, targetB1 = 0, targetB2 = 0;
+		};
+		// `BiquadBank` coefficients (one entry per channel), and the ramp state for them
+		template<typename Sample, int coeffChannels>
+		struct BankCoeffs {
+			std::array<Sample, coeffChannels> a1, a2, b0, b1, b2;
+		};
+		template<class Coeffs, bool ramping>
+		struct BankRampState {};
+		template<class Coeffs>
+		struct BankRampState<Coeffs, true> {
+			Coeffs rampStep, rampTarget;
+			int rampRemaining = 0;
+		};
+	}
+
 	/** A standard biquad.
 
 		This is not guaranteed to be stable if modulated at audio rate.
+
+		For blocks of samples, `.process()` gives identical results to calling it per-sample, but keeps the coefficients and state in local variables (so the compiler doesn't reload/store them for every sample).
 		
 		The default highpass/lowpass bandwidth (`defaultBandwidth`) produces a Butterworth filter when bandwidth-compensation is disabled.
 		
-		Bandwidth compensation defaults to `BiquadDesign::oneSided` (or `BiquadDesign::cookbook` if `cookbookBandwidth` is enabled) for all filter types aside from highpass/lowpass (which use `BiquadDesign::bilinear`).*/
-	template<typename Sample, bool cookbookBandwidth=false>
-	class BiquadStatic {
+		Bandwidth compensation defaults to `BiquadDesign::oneSided` (or `BiquadDesign::cookbook` if `cookbookBandwidth` is enabled) for all filter types aside from highpass/lowpass (which use `BiquadDesign::bilinear`).
+		
+		If `ramping` is enabled, `.rampTo()` can move the coefficients smoothly to a new design (see `BiquadRamped`).  This adds state and a per-sample check, so it's off by default.*/
+	template<typename Sample, bool cookbookBandwidth=false, bool ramping=false>
+	class BiquadStatic : _biquad_impl::RampState<Sample, ramping> /* empty-base-class optimisation when not ramping */ {
+		template<typename, bool, bool>
+		friend class BiquadStatic;
+		template<typename, int, bool, bool>
+		friend class BiquadBank;
+		template<typename, bool>
+		friend class BiquadCascade;
+		template<typename>
+		friend class SVF;
+		template<typename>
+		friend class BiquadBlockParallel;
+		template<typename>
+		friend class Crossover;
+
 		static constexpr BiquadDesign bwDesign = cookbookBandwidth ? BiquadDesign::cookbook : BiquadDesign::oneSided;
 		Sample a1 = 0, a2 = 0, b0 = 1, b1 = 0, b2 = 0;
 		Sample x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+		using Ramping = std::integral_constant<bool, ramping>;
+		void cancelRamp(std::false_type) {}
+		void cancelRamp(std::true_type) {
+			this->rampRemaining = 0;
+		}
+		SIGNALSMITH_INLINE void stepRamp(std::false_type) {}
+		SIGNALSMITH_INLINE void stepRamp(std::true_type) {
+			if (this->rampRemaining > 0) {
+				if (--this->rampRemaining > 0) {
+					a1 += this->stepA1;
+					a2 += this->stepA2;
+					b0 += this->stepB0;
+					b1 += this->stepB1;
+					b2 += this->stepB2;
+				} else {
+					a1 = this->targetA1;
+					a2 = this->targetA2;
+					b0 = this->targetB0;
+					b1 = this->targetB1;
+					b2 = this->targetB2;
+				}
+			}
+		}
+		// Processes any ramp at the start of a block, returning the number of samples done
+		int processRamp(std::false_type, const Sample *, Sample *, int) {
+			return 0;
+		}
+		int processRamp(std::true_type, const Sample *input, Sample *output, int length) {
+			if (this->rampRemaining <= 0) return 0;
+			Sample lb0 = b0, lb1 = b1, lb2 = b2, la1 = a1, la2 = a2;
+			Sample lx1 = x1, lx2 = x2, ly1 = y1, ly2 = y2;
+			// The ramp (except its last sample), then the exact target
+			int rampLength = std::min(length, this->rampRemaining - 1);
+			Sample sb0 = this->stepB0, sb1 = this->stepB1, sb2 = this->stepB2, sa1 = this->stepA1, sa2 = this->stepA2;
+			for (int i = 0; i < rampLength; ++i) {
+				lb0 += sb0;
+				lb1 += sb1;
+				lb2 += sb2;
+				la1 += sa1;
+				la2 += sa2;
+				Sample x0 = input[i];
+				Sample y0 = x0*lb0 + lx1*lb1 + lx2*lb2 - ly1*la1 - ly2*la2;
+				ly2 = ly1;
+				ly1 = y0;
+				lx2 = lx1;
+				lx1 = x0;
+				output[i] = y0;
+			}
+			this->rampRemaining -= rampLength;
+			if (rampLength < length) {
+				this->rampRemaining = 0;
+				lb0 = this->targetB0;
+				lb1 = this->targetB1;
+				lb2 = this->targetB2;
+				la1 = this->targetA1;
+				la2 = this->targetA2;
+			}
+			b0 = lb0;
+			b1 = lb1;
+			b2 = lb2;
+			a1 = la1;
+			a2 = la2;
+			x1 = lx1;
+			x2 = lx2;
+			y1 = ly1;
+			y2 = ly2;
+			return rampLength;
+		}
 		
 		enum class Type {highpass, lowpass, highShelf, lowShelf, bandpass, notch, peak, allpass};
 
@@ -55,21 +180,36 @@ namespace filters {
 			double w0, sinW0, cosW0;
 			double inv2Q;
 			
-			FreqSpec(double freq, BiquadDesign design) {
+			FreqSpec(double freq, BiquadDesign design, bool fast=false) {
 				scaledFreq = std::max(1e-6, std::min(0.4999, freq));
 				if (design == BiquadDesign::cookbook) {
 					scaledFreq = std::min(0.45, scaledFreq);
 				}
 				w0 = 2*M_PI*scaledFreq;
-				cosW0 = std::cos(w0);
-				sinW0 = std::sin(w0);
+				if (fast) {
+					double s, c;
+					fastSinCosPi(scaledFreq, s, c);
+					sinW0 = 2*s*c;
+					cosW0 = c*c - s*s;
+				} else {
+					cosW0 = std::cos(w0);
+					sinW0 = std::sin(w0);
+				}
 			}
 			
-			void oneSidedCompQ() {
+			void oneSidedCompQ(bool fast=false) {
 				// Ratio between our (digital) lower boundary f1 and centre f0
 				double f1Factor = std::sqrt(inv2Q*inv2Q + 1) - inv2Q;
 				// Bilinear means discrete-time freq f = continuous-time freq tan(pi*xf/pi)
-				double ctF1 = std::tan(M_PI*scaledFreq*f1Factor), invCtF0 = (1 + cosW0)/sinW0;
+				double ctF1;
+				if (fast) {
+					double s, c;
+					fastSinCosPi(scaledFreq*f1Factor, s, c);
+					ctF1 = s/c;
+				} else {
+					ctF1 = std::tan(M_PI*scaledFreq*f1Factor);
+				}
+				double invCtF0 = (1 + cosW0)/sinW0;
 				double ctF1Factor = ctF1*invCtF0;
 				inv2Q = 0.5/ctF1Factor - 0.5*ctF1Factor;
 			}
@@ -85,19 +225,41 @@ namespace filters {
 			if (design == BiquadDesign::oneSided) spec.oneSidedCompQ();
 			return spec;
 		}
-		SIGNALSMITH_INLINE static FreqSpec qSpec(double scaledFreq, double q, BiquadDesign design) {
-			FreqSpec spec(scaledFreq, design);
+		SIGNALSMITH_INLINE static FreqSpec qSpec(double scaledFreq, double q, BiquadDesign design, bool fast=false) {
+			// Vicanek uses exp()/cosh() etc. anyway, so there's no fast version
+			fast = fast && (design != BiquadDesign::vicanek);
+			FreqSpec spec(scaledFreq, design, fast);
 
 			spec.inv2Q = 0.5/q;
-			if (design == BiquadDesign::oneSided) spec.oneSidedCompQ();
+			if (design == BiquadDesign::oneSided) spec.oneSidedCompQ(fast);
 			return spec;
 		}
 		
-		SIGNALSMITH_INLINE double dbToSqrtGain(double db) {
+		SIGNALSMITH_INLINE static double dbToSqrtGain(double db) {
 			return std::pow(10, db*0.025);
 		}
+
+		// sin(pi*x) and cos(pi*x) for x in [0, 0.5], from Taylor series (error < 1e-13)
+		SIGNALSMITH_INLINE static void fastSinCosPi(double x, double &sinOut, double &cosOut) {
+			// Reflect around 0.25 so that both are accurate near 0 (and Nyquist)
+			bool reflect = (x > 0.25);
+			double y = M_PI*(reflect ? 0.5 - x : x), y2 = y*y;
+			double s = y*(1 + y2*(-1.0/6 + y2*(1.0/120 + y2*(-1.0/5040 + y2*(1.0/362880 + y2*(-1.0/39916800 + y2*(1.0/6227020800)))))));
+			double c = 1 + y2*(-0.5 + y2*(1.0/24 + y2*(-1.0/720 + y2*(1.0/40320 + y2*(-1.0/3628800 + y2*(1.0/479001600 + y2*(-1.0/87178291200)))))));
+			sinOut = reflect ? c : s;
+			cosOut = reflect ? s : c;
+		}
+		// 10^(db/40), using 2^n and a Taylor series for the remainder (relative error < 1e-12)
+		SIGNALSMITH_INLINE static double fastDbToSqrtGain(double db) {
+			double x = db*(0.025*3.321928094887362); // log2(10)
+			int n = int(x + (x < 0 ? -0.5 : 0.5)); // rounding, without std::floor()
+			double f = (x - n)*0.6931471805599453; // ln(2)
+			double e = 1 + f*(1 + f*(1.0/2 + f*(1.0/6 + f*(1.0/24 + f*(1.0/120 + f*(1.0/720 + f*(1.0/5040 + f*(1.0/40320 + f*(1.0/362880 + f/3628800)))))))));
+			return std::ldexp(e, n);
+		}
 		
 		SIGNALSMITH_INLINE BiquadStatic & configure(Type type, FreqSpec calc, double sqrtGain, BiquadDesign design) {
+			cancelRamp(Ramping());
 			double w0 = calc.w0;
 			
 			if (design == BiquadDesign::vicanek) {
@@ -172,76 +334,145 @@ namespace filters {
 			double alpha = calc.sinW0*calc.inv2Q;
 			double A = sqrtGain, sqrtA2alpha = 2*std::sqrt(A)*alpha;
 
-			double a0;
+			// Computed in `double` and rounded once, so `float` filters don't depend on where the optimiser rounds intermediate values
+			double da0, da1, da2, db0, db1, db2;
 			if (type == Type::highpass) {
-				b1 = -1 - calc.cosW0;
-				b0 = b2 = (1 + calc.cosW0)*0.5;
-				a0 = 1 + alpha;
-				a1 = -2*calc.cosW0;
-				a2 = 1 - alpha;
+				db1 = -1 - calc.cosW0;
+				db0 = db2 = (1 + calc.cosW0)*0.5;
+				da0 = 1 + alpha;
+				da1 = -2*calc.cosW0;
+				da2 = 1 - alpha;
 			} else if (type == Type::lowpass) {
-				b1 = 1 - calc.cosW0;
-				b0 = b2 = b1*0.5;
-				a0 = 1 + alpha;
-				a1 = -2*calc.cosW0;
-				a2 = 1 - alpha;
+				db1 = 1 - calc.cosW0;
+				db0 = db2 = db1*0.5;
+				da0 = 1 + alpha;
+				da1 = -2*calc.cosW0;
+				da2 = 1 - alpha;
 			} else if (type == Type::highShelf) {
-				b0 = A*((A+1)+(A-1)*calc.cosW0+sqrtA2alpha);
-				b2 = A*((A+1)+(A-1)*calc.cosW0-sqrtA2alpha);
-				b1 = -2*A*((A-1)+(A+1)*calc.cosW0);
-				a0 = (A+1)-(A-1)*calc.cosW0+sqrtA2alpha;
-				a2 = (A+1)-(A-1)*calc.cosW0-sqrtA2alpha;
-				a1 = 2*((A-1)-(A+1)*calc.cosW0);
+				db0 = A*((A+1)+(A-1)*calc.cosW0+sqrtA2alpha);
+				db2 = A*((A+1)+(A-1)*calc.cosW0-sqrtA2alpha);
+				db1 = -2*A*((A-1)+(A+1)*calc.cosW0);
+				da0 = (A+1)-(A-1)*calc.cosW0+sqrtA2alpha;
+				da2 = (A+1)-(A-1)*calc.cosW0-sqrtA2alpha;
+				da1 = 2*((A-1)-(A+1)*calc.cosW0);
 			} else if (type == Type::lowShelf) {
-				b0 = A*((A+1)-(A-1)*calc.cosW0+sqrtA2alpha);
-				b2 = A*((A+1)-(A-1)*calc.cosW0-sqrtA2alpha);
-				b1 = 2*A*((A-1)-(A+1)*calc.cosW0);
-				a0 = (A+1)+(A-1)*calc.cosW0+sqrtA2alpha;
-				a2 = (A+1)+(A-1)*calc.cosW0-sqrtA2alpha;
-				a1 = -2*((A-1)+(A+1)*calc.cosW0);
+				db0 = A*((A+1)-(A-1)*calc.cosW0+sqrtA2alpha);
+				db2 = A*((A+1)-(A-1)*calc.cosW0-sqrtA2alpha);
+				db1 = 2*A*((A-1)-(A+1)*calc.cosW0);
+				da0 = (A+1)+(A-1)*calc.cosW0+sqrtA2alpha;
+				da2 = (A+1)+(A-1)*calc.cosW0-sqrtA2alpha;
+				da1 = -2*((A-1)+(A+1)*calc.cosW0);
 			} else if (type == Type::bandpass) {
-				b0 = alpha;
-				b1 = 0;
-				b2 = -alpha;
-				a0 = 1 + alpha;
-				a1 = -2*calc.cosW0;
-				a2 = 1 - alpha;
+				db0 = alpha;
+				db1 = 0;
+				db2 = -alpha;
+				da0 = 1 + alpha;
+				da1 = -2*calc.cosW0;
+				da2 = 1 - alpha;
 			} else if (type == Type::notch) {
-				b0 = 1;
-				b1 = -2*calc.cosW0;
-				b2 = 1;
-				a0 = 1 + alpha;
-				a1 = b1;
-				a2 = 1 - alpha;
+				db0 = 1;
+				db1 = -2*calc.cosW0;
+				db2 = 1;
+				da0 = 1 + alpha;
+				da1 = db1;
+				da2 = 1 - alpha;
 			} else if (type == Type::peak) {
-				b0 = 1 + alpha*A;
-				b1 = -2*calc.cosW0;
-				b2 = 1 - alpha*A;
-				a0 = 1 + alpha/A;
-				a1 = b1;
-				a2 = 1 - alpha/A;
+				db0 = 1 + alpha*A;
+				db1 = -2*calc.cosW0;
+				db2 = 1 - alpha*A;
+				da0 = 1 + alpha/A;
+				da1 = db1;
+				da2 = 1 - alpha/A;
 			} else if (type == Type::allpass) {
-				a0 = b2 = 1 + alpha;
-				a1 = b1 = -2*calc.cosW0;
-				a2 = b0 = 1 - alpha;
+				da0 = db2 = 1 + alpha;
+				da1 = db1 = -2*calc.cosW0;
+				da2 = db0 = 1 - alpha;
 			} else {
 				// reset to neutral
-				a1 = a2 = b1 = b2 = 0;
-				a0 = b0 = 1;
-			}
-			double invA0 = 1/a0;
-			b0 *= invA0;
-			b1 *= invA0;
-			b2 *= invA0;
-			a1 *= invA0;
-			a2 *= invA0;
+				da1 = da2 = db1 = db2 = 0;
+				da0 = db0 = 1;
+			}
+			double invA0 = 1/da0;
+			b0 = db0*invA0;
+			b1 = db1*invA0;
+			b2 = db2*invA0;
+			a1 = da1*invA0;
+			a2 = da2*invA0;
 			return *this;
 		}
+
+		static constexpr int responseChunk = 64;
+		// Multiplies the responses of all the filters, for z^-1 given as separate real/imaginary arrays
+		template<class Filters, class Output>
+		SIGNALSMITH_INLINE static void responseChunkProduct(const Filters &filters, int filterCount, const Sample *zr, const Sample *zi, int length, Output &&output) {
+			Sample hr[responseChunk], hi[responseChunk];
+			for (int i = 0; i < length; ++i) {
+				hr[i] = 1;
+				hi[i] = 0;
+			}
+			for (int f = 0; f < filterCount; ++f) {
+				const BiquadStatic &filter = filters[f];
+				Sample fb0 = filter.b0, fb1 = filter.b1, fb2 = filter.b2, fa1 = filter.a1, fa2 = filter.a2;
+				for (int i = 0; i < length; ++i) {
+					Sample z2r = zr[i]*zr[i] - zi[i]*zi[i], z2i = 2*zr[i]*zi[i];
+					Sample nr = fb0 + fb1*zr[i] + fb2*z2r, ni = fb1*zi[i] + fb2*z2i;
+					Sample dr = 1 + fa1*zr[i] + fa2*z2r, di = fa1*zi[i] + fa2*z2i;
+					// Multiply by numerator*conj(denominator)/|denominator|^2
+					Sample invNorm = 1/(dr*dr + di*di);
+					Sample qr = (nr*dr + ni*di)*invNorm, qi = (ni*dr - nr*di)*invNorm;
+					Sample r = hr[i]*qr - hi[i]*qi;
+					hi[i] = hr[i]*qi + hi[i]*qr;
+					hr[i] = r;
+				}
+			}
+			for (int i = 0; i < length; ++i) output(i, hr[i], hi[i]);
+		}
+		// Calls `output(index, real, imag)` for linearly-spaced frequencies
+		template<class Filters, class Output>
+		static void responsesLinearImpl(const Filters &filters, int filterCount, Sample startFreq, Sample stepFreq, int count, Output &&output) {
+			// Rotations within a chunk are computed once, and applied to an exact starting point for each chunk (so errors don't accumulate)
+			Sample rotR[responseChunk], rotI[responseChunk], zr[responseChunk], zi[responseChunk];
+			for (int i = 0; i < responseChunk; ++i) {
+				double w = 2*M_PI*stepFreq*i;
+				rotR[i] = std::cos(w);
+				rotI[i] = -std::sin(w);
+			}
+			for (int start = 0; start < count; start += responseChunk) {
+				int length = std::min<int>(int(responseChunk), count - start);
+				double w = 2*M_PI*(startFreq + double(stepFreq)*start);
+				Sample startR = std::cos(w), startI = -std::sin(w);
+				for (int i = 0; i < length; ++i) {
+					zr[i] = startR*rotR[i] - startI*rotI[i];
+					zi[i] = startR*rotI[i] + startI*rotR[i];
+				}
+				responseChunkProduct(filters, filterCount, zr, zi, length, [&](int i, Sample r, Sample im) {
+					output(start + i, r, im);
+				});
+			}
+		}
+		// Calls `output(index, real, imag)` for arbitrary frequencies
+		template<class Filters, class Output>
+		static void responsesImpl(const Filters &filters, int filterCount, const Sample *scaledFreqs, int count, Output &&output) {
+			Sample zr[responseChunk], zi[responseChunk];
+			for (int start = 0; start < count; start += responseChunk) {
+				int length = std::min<int>(int(responseChunk), count - start);
+				for (int i = 0; i < length; ++i) {
+					double s, c;
+					fastSinCosPi(std::max(0.0, std::min(0.5, double(scaledFreqs[start + i]))), s, c);
+					zr[i] = c*c - s*s;
+					zi[i] = -2*s*c;
+				}
+				responseChunkProduct(filters, filterCount, zr, zi, length, [&](int i, Sample r, Sample im) {
+					output(start + i, r, im);
+				});
+			}
+		}
 	public:
 		static constexpr double defaultQ = 0.7071067811865476; // sqrt(0.5)
 		static constexpr double defaultBandwidth = 1.8999686269529916; // equivalent to above Q
 
 		Sample operator ()(Sample x0) {
+			stepRamp(Ramping());
 			Sample y0 = x0*b0 + x1*b1 + x2*b2 - y1*a1 - y2*a2;
 			y2 = y1;
 			y1 = y0;
@@ -249,17 +480,80 @@ namespace filters {
 			x1 = x0;
 			return y0;
 		}
+
+		/// Processes a block of samples, which can be in-place
+		void process(const Sample *input, Sample *output, int length) {
+			int start = processRamp(Ramping(), input, output, length);
+			input += start;
+			output += start;
+			length -= start;
+			// Local copies, since `output` could alias our members
+			Sample lb0 = b0, lb1 = b1, lb2 = b2, la1 = a1, la2 = a2;
+			Sample lx1 = x1, lx2 = x2, ly1 = y1, ly2 = y2;
+			for (int i = 0; i < length; ++i) {
+				Sample x0 = input[i];
+				Sample y0 = x0*lb0 + lx1*lb1 + lx2*lb2 - ly1*la1 - ly2*la2;
+				ly2 = ly1;
+				ly1 = y0;
+				lx2 = lx1;
+				lx1 = x0;
+				output[i] = y0;
+			}
+			x1 = lx1;
+			x2 = lx2;
+			y1 = ly1;
+			y2 = ly2;
+		}
+		/// Processes a block of samples in-place
+		void process(Sample *data, int length) {
+			process(data, data, length);
+		}
 		
 		void reset() {
 			x1 = x2 = y1 = y2 = 0;
 		}
 		
-		void copyFrom(const BiquadStatic &other) {
+		template<bool otherCookbook, bool otherRamping>
+		void copyFrom(const BiquadStatic<Sample, otherCookbook, otherRamping> &other) {
 			b0 = other.b0;
 			b1 = other.b1;
 			b2 = other.b2;
 			a1 = other.a1;
 			a2 = other.a2;
+			cancelRamp(Ramping());
+		}
+
+		/** Linearly ramps the coefficients from their current values to those of `target`, over the next `samples` samples (reaching `target` exactly on the last one).  Only available when `ramping` is enabled:
+			\code
+				BiquadRamped<float> filter;
+				filter.rampTo(BiquadStatic<float>().lowpass(newFreq), 64);
+			\endcode
+			The stable region for `(a1, a2)` is convex, so every intermediate filter is stable if both ends are.  Designing or `.copyFrom()` cancels the ramp.*/
+		template<bool otherCookbook, bool otherRamping>
+		BiquadStatic & rampTo(const BiquadStatic<Sample, otherCookbook, otherRamping> &target, int samples) {
+			static_assert(ramping, "rampTo() needs ramping enabled (e.g. BiquadRamped)");
+			if (samples <= 0) {
+				copyFrom(target);
+				return *this;
+			}
+			Sample scale = Sample(1)/samples;
+			this->stepA1 = (target.a1 - a1)*scale;
+			this->stepA2 = (target.a2 - a2)*scale;
+			this->stepB0 = (target.b0 - b0)*scale;
+			this->stepB1 = (target.b1 - b1)*scale;
+			this->stepB2 = (target.b2 - b2)*scale;
+			this->targetA1 = target.a1;
+			this->targetA2 = target.a2;
+			this->targetB0 = target.b0;
+			this->targetB1 = target.b1;
+			this->targetB2 = target.b2;
+			this->rampRemaining = samples;
+			return *this;
+		}
+		/// Samples left in the current coefficient ramp
+		int rampSamples() const {
+			static_assert(ramping, "rampSamples() needs ramping enabled (e.g. BiquadRamped)");
+			return this->rampRemaining;
 		}
 		
 		std::complex<Sample> response(Sample scaledFreq) const {
@@ -274,6 +568,41 @@ namespace filters {
 			return 10*std::log10(energy);
 		}
 
+		/** @name Batch responses
+			These evaluate the combined response of several filters (`filters[0]` to `filters[filterCount - 1]`) at many frequencies at once, e.g. for drawing an EQ curve:
+			\code
+				std::vector<BiquadStatic<float>> bands;
+				std::vector<float> curveDb(2048);
+				BiquadStatic<float>::responsesDbLinear(bands, bands.size(), 0, 0.5/2047, curveDb.data(), 2048);
+			\endcode
+			Frequencies are processed in chunks, stored as separate real/imaginary arrays so the per-filter loop can be vectorised.  For linearly-spaced frequencies, z^-1 is rotated from an exact starting point in each chunk, instead of using trig for every point.  Arbitrary frequencies (in the range 0-0.5) use the same polynomial approximations as the `...Fast()` designs.
+			@{ */
+		template<class Filters>
+		static void responsesLinear(const Filters &filters, int filterCount, Sample startFreq, Sample stepFreq, std::complex<Sample> *output, int count) {
+			responsesLinearImpl(filters, filterCount, startFreq, stepFreq, count, [&](int i, Sample r, Sample im) {
+				output[i] = {r, im};
+			});
+		}
+		template<class Filters>
+		static void responsesDbLinear(const Filters &filters, int filterCount, Sample startFreq, Sample stepFreq, Sample *outputDb, int count) {
+			responsesLinearImpl(filters, filterCount, startFreq, stepFreq, count, [&](int i, Sample r, Sample im) {
+				outputDb[i] = 10*std::log10(r*r + im*im);
+			});
+		}
+		template<class Filters>
+		static void responses(const Filters &filters, int filterCount, const Sample *scaledFreqs, std::complex<Sample> *output, int count) {
+			responsesImpl(filters, filterCount, scaledFreqs, count, [&](int i, Sample r, Sample im) {
+				output[i] = {r, im};
+			});
+		}
+		template<class Filters>
+		static void responsesDb(const Filters &filters, int filterCount, const Sample *scaledFreqs, Sample *outputDb, int count) {
+			responsesImpl(filters, filterCount, scaledFreqs, count, [&](int i, Sample r, Sample im) {
+				outputDb[i] = 10*std::log10(r*r + im*im);
+			});
+		}
+		/// @}
+
 		/// @name Lowpass
 		/// @{
 		BiquadStatic & lowpass(double scaledFreq, double octaves=defaultBandwidth, BiquadDesign design=BiquadDesign::bilinear) {
@@ -428,10 +757,43 @@ namespace filters {
 		}
 		/// @}
 
+		/** @name Fast redesign
+			These replace the standard library's trig/`pow()` functions with polynomial approximations (error below 1e-13), for filters which are redesigned often (e.g. every few samples).  For the `bilinear`, `cookbook` and `oneSided` designs, the responses match the corresponding `...Q()` methods to within ~1e-8.  `BiquadDesign::vicanek` has no fast version, so it's identical to the normal method.
+			\code
+				filter.lowpassQFast(envelope*0.1, 2);
+			\endcode
+			@{ */
+		BiquadStatic & lowpassQFast(double scaledFreq, double q, BiquadDesign design=BiquadDesign::bilinear) {
+			return configure(Type::lowpass, qSpec(scaledFreq, q, design, true), 0, design);
+		}
+		BiquadStatic & highpassQFast(double scaledFreq, double q, BiquadDesign design=BiquadDesign::bilinear) {
+			return configure(Type::highpass, qSpec(scaledFreq, q, design, true), 0, design);
+		}
+		BiquadStatic & bandpassQFast(double scaledFreq, double q, BiquadDesign design=bwDesign) {
+			return configure(Type::bandpass, qSpec(scaledFreq, q, design, true), 0, design);
+		}
+		BiquadStatic & notchQFast(double scaledFreq, double q, BiquadDesign design=bwDesign) {
+			return configure(Type::notch, qSpec(scaledFreq, q, design, true), 0, design);
+		}
+		BiquadStatic & peakDbQFast(double scaledFreq, double db, double q, BiquadDesign design=bwDesign) {
+			return configure(Type::peak, qSpec(scaledFreq, q, design, true), fastDbToSqrtGain(db), design);
+		}
+		BiquadStatic & highShelfDbQFast(double scaledFreq, double db, double q, BiquadDesign design=bwDesign) {
+			return configure(Type::highShelf, qSpec(scaledFreq, q, design, true), fastDbToSqrtGain(db), design);
+		}
+		BiquadStatic & lowShelfDbQFast(double scaledFreq, double db, double q, BiquadDesign design=bwDesign) {
+			return configure(Type::lowShelf, qSpec(scaledFreq, q, design, true), fastDbToSqrtGain(db), design);
+		}
+		BiquadStatic & allpassQFast(double scaledFreq, double q, BiquadDesign design=bwDesign) {
+			return configure(Type::allpass, qSpec(scaledFreq, q, design, true), 0, design);
+		}
+		/// @}
+
 		BiquadStatic & addGain(double factor) {
 			b0 *= factor;
 			b1 *= factor;
 			b2 *= factor;
+			cancelRamp(Ramping());
 			return *this;
 		}
 		BiquadStatic & addGainDb(double db) {
@@ -439,6 +801,1353 @@ namespace filters {
 		}
 	};
 
+	/// A `BiquadStatic` with coefficient ramping enabled (see `BiquadStatic::rampTo()`)
+	template<typename Sample, bool cookbookBandwidth=false>
+	using BiquadRamped = BiquadStatic<Sample, cookbookBandwidth, true>;
+
+	/** @brief A bank of biquads for a fixed number of channels, processed together
+
+		The coefficients and state are stored as separate arrays (one entry per channel), so the per-channel loop can be vectorised by the compiler.  If `sharedCoefficients` is enabled, all channels use the same coefficients.
+
+		Filters are designed using `BiquadStatic`, and then copied in:
+		\code
+			BiquadBank<float, 8> bank;
+			bank.copyFrom(BiquadStatic<float>().lowpass(0.1)); // all channels
+			bank.copyFrom(3, BiquadStatic<float>().highShelfDb(0.2, -3)); // one channel
+		\endcode
+		
+		Each channel's output is identical to a separate `BiquadStatic` with the same coefficients.
+
+		If `ramping` is enabled, the coefficients can be ramped with `.rampTo()`/`.rampEachTo()`, as with `BiquadRamped`.
+	*/
+	template<typename Sample, int channels, bool sharedCoefficients=false, bool ramping=false>
+	class BiquadBank : _biquad_impl::BankRampState<_biquad_impl::BankCoeffs<Sample, sharedCoefficients ? 1 : channels>, ramping> {
+		static constexpr int coeffChannels = sharedCoefficients ? 1 : channels;
+		using Coeffs = _biquad_impl::BankCoeffs<Sample, coeffChannels>;
+		Coeffs coeffs;
+		struct State {
+			std::array<Sample, channels> x1, x2, y1, y2;
+		} state;
+
+		using Ramping = std::integral_constant<bool, ramping>;
+		template<class Filter>
+		void copyCoeffs(int c, const Filter &filter) {
+			coeffs.a1[c] = Sample(filter.a1);
+			coeffs.a2[c] = Sample(filter.a2);
+			coeffs.b0[c] = Sample(filter.b0);
+			coeffs.b1[c] = Sample(filter.b1);
+			coeffs.b2[c] = Sample(filter.b2);
+			stopRamp(Ramping(), c);
+		}
+		void stopRamp(std::false_type, int) {}
+		// Stops this channel ramping, if there's a ramp in progress
+		void stopRamp(std::true_type, int c) {
+			Coeffs &target = this->rampTarget, &step = this->rampStep;
+			target.a1[c] = coeffs.a1[c];
+			target.a2[c] = coeffs.a2[c];
+			target.b0[c] = coeffs.b0[c];
+			target.b1[c] = coeffs.b1[c];
+			target.b2[c] = coeffs.b2[c];
+			step.a1[c] = step.a2[c] = step.b0[c] = step.b1[c] = step.b2[c] = 0;
+		}
+		template<class Filter>
+		void rampCoeffs(int c, const Filter &filter, Sample scale) {
+			Coeffs &target = this->rampTarget, &step = this->rampStep;
+			target.a1[c] = Sample(filter.a1);
+			target.a2[c] = Sample(filter.a2);
+			target.b0[c] = Sample(filter.b0);
+			target.b1[c] = Sample(filter.b1);
+			target.b2[c] = Sample(filter.b2);
+			step.a1[c] = (target.a1[c] - coeffs.a1[c])*scale;
+			step.a2[c] = (target.a2[c] - coeffs.a2[c])*scale;
+			step.b0[c] = (target.b0[c] - coeffs.b0[c])*scale;
+			step.b1[c] = (target.b1[c] - coeffs.b1[c])*scale;
+			step.b2[c] = (target.b2[c] - coeffs.b2[c])*scale;
+		}
+		SIGNALSMITH_INLINE void stepRamp(std::false_type, Coeffs &) {}
+		SIGNALSMITH_INLINE void stepRamp(std::true_type, Coeffs &k) {
+			if (this->rampRemaining <= 0) return;
+			if (--this->rampRemaining > 0) {
+				const Coeffs &step = this->rampStep;
+				for (int c = 0; c < coeffChannels; ++c) {
+					k.a1[c] += step.a1[c];
+					k.a2[c] += step.a2[c];
+					k.b0[c] += step.b0[c];
+					k.b1[c] += step.b1[c];
+					k.b2[c] += step.b2[c];
+				}
+			} else {
+				k = this->rampTarget;
+			}
+		}
+
+		using Designer = BiquadStatic<Sample>;
+		using DesignType = typename Designer::Type;
+		template<class Freqs>
+		SIGNALSMITH_INLINE BiquadBank & designFast(DesignType type, Freqs &&scaledFreqs, double q, double db, BiquadDesign design) {
+			static_assert(!sharedCoefficients, "can't set individual channels when coefficients are shared");
+			Designer designer;
+			double sqrtGain = Designer::fastDbToSqrtGain(db);
+			for (int c = 0; c < channels; ++c) {
+				designer.configure(type, Designer::qSpec(scaledFreqs[c], q, design, true), sqrtGain, design);
+				copyCoeffs(c, designer);
+			}
+			return *this;
+		}
+
+		SIGNALSMITH_INLINE static void processFrame(const Coeffs &k, State &s, const Sample *input, Sample *output) {
+			for (int c = 0; c < channels; ++c) {
+				int cc = sharedCoefficients ? 0 : c;
+				Sample x0 = input[c];
+				Sample y0 = x0*k.b0[cc] + s.x1[c]*k.b1[cc] + s.x2[c]*k.b2[cc] - s.y1[c]*k.a1[cc] - s.y2[c]*k.a2[cc];
+				s.y2[c] = s.y1[c];
+				s.y1[c] = y0;
+				s.x2[c] = s.x1[c];
+				s.x1[c] = x0;
+				output[c] = y0;
+			}
+		}
+	public:
+		BiquadBank() {
+			copyFrom(BiquadStatic<Sample>()); // neutral
+			reset();
+		}
+
+		void reset() {
+			for (int c = 0; c < channels; ++c) {
+				state.x1[c] = state.x2[c] = state.y1[c] = state.y2[c] = 0;
+			}
+		}
+
+		/// Copies coefficients (but not state) from a `BiquadStatic` into every channel
+		template<typename OtherSample, bool otherCookbook, bool otherRamping>
+		BiquadBank & copyFrom(const BiquadStatic<OtherSample, otherCookbook, otherRamping> &filter) {
+			for (int c = 0; c < coeffChannels; ++c) {
+				copyCoeffs(c, filter);
+			}
+			return *this;
+		}
+		/// Copies coefficients (but not state) from a `BiquadStatic` into a single channel
+		template<typename OtherSample, bool otherCookbook, bool otherRamping>
+		BiquadBank & copyFrom(int channel, const BiquadStatic<OtherSample, otherCookbook, otherRamping> &filter) {
+			static_assert(!sharedCoefficients, "can't set individual channels when coefficients are shared");
+			copyCoeffs(channel, filter);
+			return *this;
+		}
+
+		/** Linearly ramps every channel's coefficients to those of `filter`, over the next `samples` samples (see `BiquadStatic::rampTo()`).  Only available when `ramping` is enabled.
+			Copying or designing a channel during a ramp stops it ramping.*/
+		template<typename OtherSample, bool otherCookbook, bool otherRamping>
+		BiquadBank & rampTo(const BiquadStatic<OtherSample, otherCookbook, otherRamping> &filter, int samples) {
+			static_assert(ramping, "rampTo() needs ramping enabled");
+			if (samples <= 0) return copyFrom(filter);
+			for (int c = 0; c < coeffChannels; ++c) {
+				rampCoeffs(c, filter, Sample(1)/samples);
+			}
+			this->rampRemaining = samples;
+			return *this;
+		}
+		/// Ramps each channel to the coefficients of `filters[c]`
+		template<class Filters>
+		BiquadBank & rampEachTo(const Filters &filters, int samples) {
+			static_assert(ramping, "rampEachTo() needs ramping enabled");
+			static_assert(!sharedCoefficients, "can't set individual channels when coefficients are shared");
+			for (int c = 0; c < channels; ++c) {
+				if (samples <= 0) {
+					copyCoeffs(c, filters[c]);
+				} else {
+					rampCoeffs(c, filters[c], Sample(1)/samples);
+				}
+			}
+			this->rampRemaining = std::max(samples, 0);
+			return *this;
+		}
+		int rampSamples() const {
+			static_assert(ramping, "rampSamples() needs ramping enabled");
+			return this->rampRemaining;
+		}
+
+		/** @name Batch redesign
+			Redesigns every channel (from `scaledFreqs[c]`), using the fast approximations from `BiquadStatic` (e.g. `.lowpassQFast()`).
+			@{ */
+		template<class Freqs>
+		BiquadBank & lowpassQFast(Freqs &&scaledFreqs, double q, BiquadDesign design=BiquadDesign::bilinear) {
+			return designFast(DesignType::lowpass, scaledFreqs, q, 0, design);
+		}
+		template<class Freqs>
+		BiquadBank & highpassQFast(Freqs &&scaledFreqs, double q, BiquadDesign design=BiquadDesign::bilinear) {
+			return designFast(DesignType::highpass, scaledFreqs, q, 0, design);
+		}
+		template<class Freqs>
+		BiquadBank & bandpassQFast(Freqs &&scaledFreqs, double q, BiquadDesign design=BiquadDesign::oneSided) {
+			return designFast(DesignType::bandpass, scaledFreqs, q, 0, design);
+		}
+		template<class Freqs>
+		BiquadBank & notchQFast(Freqs &&scaledFreqs, double q, BiquadDesign design=BiquadDesign::oneSided) {
+			return designFast(DesignType::notch, scaledFreqs, q, 0, design);
+		}
+		template<class Freqs>
+		BiquadBank & peakDbQFast(Freqs &&scaledFreqs, double db, double q, BiquadDesign design=BiquadDesign::oneSided) {
+			return designFast(DesignType::peak, scaledFreqs, q, db, design);
+		}
+		template<class Freqs>
+		BiquadBank & highShelfDbQFast(Freqs &&scaledFreqs, double db, double q, BiquadDesign design=BiquadDesign::oneSided) {
+			return designFast(DesignType::highShelf, scaledFreqs, q, db, design);
+		}
+		template<class Freqs>
+		BiquadBank & lowShelfDbQFast(Freqs &&scaledFreqs, double db, double q, BiquadDesign design=BiquadDesign::oneSided) {
+			return designFast(DesignType::lowShelf, scaledFreqs, q, db, design);
+		}
+		template<class Freqs>
+		BiquadBank & allpassQFast(Freqs &&scaledFreqs, double q, BiquadDesign design=BiquadDesign::oneSided) {
+			return designFast(DesignType::allpass, scaledFreqs, q, 0, design);
+		}
+		/// @}
+
+		/// Processes a single multi-channel frame (can be in-place)
+		template<class Input, class Output>
+		void operator ()(Input &&input, Output &&output) {
+			std::array<Sample, channels> inFrame, outFrame;
+			for (int c = 0; c < channels; ++c) inFrame[c] = input[c];
+			stepRamp(Ramping(), coeffs);
+			processFrame(coeffs, state, inFrame.data(), outFrame.data());
+			for (int c = 0; c < channels; ++c) output[c] = outFrame[c];
+		}
+
+		/// Processes multi-channel data where `data[c][i]` is a sample (can be in-place)
+		template<class Input, class Output>
+		void process(Input &&input, Output &&output, int length) {
+			// Local copies, since the output could alias our members
+			Coeffs k = coeffs;
+			State s = state;
+			std::array<Sample, channels> inFrame, outFrame;
+			for (int i = 0; i < length; ++i) {
+				for (int c = 0; c < channels; ++c) inFrame[c] = input[c][i];
+				stepRamp(Ramping(), k);
+				processFrame(k, s, inFrame.data(), outFrame.data());
+				for (int c = 0; c < channels; ++c) output[c][i] = outFrame[c];
+			}
+			coeffs = k;
+			state = s;
+		}
+
+		/// Processes interleaved (frame-major) data, where `data[i*channels + c]` is a sample (can be in-place)
+		void processInterleaved(const Sample *input, Sample *output, int length) {
+			Coeffs k = coeffs;
+			State s = state;
+			for (int i = 0; i < length; ++i) {
+				stepRamp(Ramping(), k);
+				processFrame(k, s, input + i*channels, output + i*channels);
+			}
+			coeffs = k;
+			state = s;
+		}
+		void processInterleaved(Sample *data, int length) {
+			processInterleaved(data, data, length);
+		}
+	};
+
+	/** @brief A cascade of second-order sections, with higher-order designs
+
+		Butterworth, Linkwitz-Riley and Chebyshev (type I) filters of any order are built from `BiquadStatic` sections.  The `design` argument is passed to each section, and odd orders add a first-order (bilinear) section.  Redesigning keeps the filter state, as with `BiquadStatic`.
+		\code
+			BiquadCascade<float> lowpass, highpass;
+			lowpass.linkwitzRileyLowpass(crossoverFreq, 4);
+			highpass.linkwitzRileyHighpass(crossoverFreq, 4);
+			lowpass.process(input, lowOutput, length);
+			highpass.process(input, highOutput, length);
+		\endcode
+
+		Blocks are processed stage-by-stage (using `BiquadStatic::process()`).  Alternatively, `.setParallel()` converts the cascade into a sum of sections (a partial-fraction expansion) which all filter the same input.  These sections are stored as arrays and updated together in a loop the compiler can vectorise.  This needs distinct poles, so isn't available for Linkwitz-Riley designs (where each pole is repeated).
+
+		Designing a new filter allocates if the number of sections increases.  If `ramping` is enabled, the sections are `BiquadRamped` and the cascade can `.rampTo()` another design.
+	*/
+	template<typename Sample, bool ramping=false>
+	class BiquadCascade {
+		template<typename, bool>
+		friend class BiquadCascade;
+		using Biquad = BiquadStatic<Sample, false, ramping>;
+		std::vector<Biquad> stages;
+
+		bool parallel = false;
+		Sample parallelDirect = 0, parallelX1 = 0;
+		std::vector<Sample> parallelB0, parallelB1, parallelA1, parallelA2, parallelY1, parallelY2;
+
+		// Bilinear first-order section, with the analog pole at `analogPole` (relative to the prewarped cutoff)
+		static void firstOrder(Biquad &stage, double scaledFreq, double analogPole, bool highpass) {
+			double w = std::tan(M_PI*std::max(1e-6, std::min(0.4999, scaledFreq)))*analogPole;
+			double invA0 = 1/(1 + w);
+			stage.a1 = (w - 1)*invA0;
+			stage.a2 = 0;
+			stage.b0 = (highpass ? 1 : w)*invA0;
+			stage.b1 = (highpass ? -1 : w)*invA0;
+			stage.b2 = 0;
+		}
+		// Section frequency whose (bilinear) prewarped frequency is `ratio` times that of `scaledFreq`
+		static double scaleFreq(double scaledFreq, double ratio) {
+			return std::atan(std::tan(M_PI*std::max(1e-6, std::min(0.4999, scaledFreq)))*ratio)/M_PI;
+		}
+
+		BiquadCascade & designChebyshev(double scaledFreq, int order, double rippleDb, bool highpass, BiquadDesign design) {
+			if (parallel) {
+				parallel = false;
+				reset();
+			}
+			stages.resize((order + 1)/2);
+			double epsilon = std::sqrt(std::pow(10, rippleDb*0.1) - 1);
+			double mu = std::asinh(1/epsilon)/order;
+			// Butterworth poles, squashed horizontally (and stretched vertically) for Chebyshev
+			double sinhMu = (rippleDb > 0) ? std::sinh(mu) : 1, coshMu = (rippleDb > 0) ? std::cosh(mu) : 1;
+			for (int k = 0; k < order/2; ++k) {
+				double theta = M_PI*(2*k + 1)/(2*order);
+				double re = sinhMu*std::sin(theta), im = coshMu*std::cos(theta);
+				double poleFreq = std::sqrt(re*re + im*im);
+				double q = poleFreq/(2*re);
+				if (highpass) {
+					stages[k].highpassQ(scaleFreq(scaledFreq, 1/poleFreq), q, design);
+				} else {
+					stages[k].lowpassQ(scaleFreq(scaledFreq, poleFreq), q, design);
+				}
+			}
+			if (order%2) {
+				firstOrder(stages.back(), scaledFreq, highpass ? 1/sinhMu : sinhMu, highpass);
+			} else if (rippleDb > 0) {
+				// Even orders start from the bottom of the ripple
+				stages[0].addGain(1/std::sqrt(1 + epsilon*epsilon));
+			}
+			return *this;
+		}
+
+		Sample processParallel(Sample x) {
+			Sample sum = x*parallelDirect;
+			int size = int(parallelB0.size());
+			for (int s = 0; s < size; ++s) {
+				Sample y = x*parallelB0[s] + parallelX1*parallelB1[s] - parallelY1[s]*parallelA1[s] - parallelY2[s]*parallelA2[s];
+				parallelY2[s] = parallelY1[s];
+				parallelY1[s] = y;
+			}
+			for (int s = 0; s < size; ++s) {
+				sum += parallelY1[s];
+			}
+			parallelX1 = x;
+			return sum;
+		}
+	public:
+		/// Number of second-order sections
+		int size() const {
+			return int(stages.size());
+		}
+		/// Individual sections, which can also be designed/replaced directly (call `.setParallel()` again afterwards if needed)
+		Biquad & operator [](int index) {
+			return stages[index];
+		}
+		const Biquad & operator [](int index) const {
+			return stages[index];
+		}
+		/// Sets the number of sections (new ones are neutral)
+		void resize(int sections) {
+			if (parallel) {
+				parallel = false;
+				reset();
+			}
+			stages.resize(sections);
+		}
+
+		void reset() {
+			for (auto &stage : stages) stage.reset();
+			parallelX1 = 0;
+			for (auto &v : parallelY1) v = 0;
+			for (auto &v : parallelY2) v = 0;
+		}
+
+		/// Ramps each section to the corresponding one in `target` (see `BiquadStatic::rampTo()`), or copies them if the number of sections is different
+		template<bool otherRamping>
+		BiquadCascade & rampTo(const BiquadCascade<Sample, otherRamping> &target, int samples) {
+			static_assert(ramping, "rampTo() needs ramping enabled");
+			if (target.size() != size()) {
+				resize(target.size());
+				samples = 0;
+			}
+			if (parallel) {
+				parallel = false;
+				reset();
+			}
+			for (int s = 0; s < size(); ++s) stages[s].rampTo(target.stages[s], samples);
+			return *this;
+		}
+
+		/// @name Butterworth
+		/// @{
+		BiquadCascade & butterworthLowpass(double scaledFreq, int order, BiquadDesign design=BiquadDesign::bilinear) {
+			return designChebyshev(scaledFreq, order, 0, false, design);
+		}
+		BiquadCascade & butterworthHighpass(double scaledFreq, int order, BiquadDesign design=BiquadDesign::bilinear) {
+			return designChebyshev(scaledFreq, order, 0, true, design);
+		}
+		/// @}
+
+		/// @name Linkwitz-Riley
+		/// Two cascaded Butterworth filters, so `order` must be even.  The lowpass/highpass are -6dB at the crossover, and (for multiples of 4) sum to an allpass.
+		/// @{
+		BiquadCascade & linkwitzRileyLowpass(double scaledFreq, int order, BiquadDesign design=BiquadDesign::bilinear) {
+			butterworthLowpass(scaledFreq, order/2, design);
+			int half = size();
+			stages.resize(half*2);
+			for (int i = 0; i < half; ++i) stages[half + i].copyFrom(stages[i]);
+			return *this;
+		}
+		BiquadCascade & linkwitzRileyHighpass(double scaledFreq, int order, BiquadDesign design=BiquadDesign::bilinear) {
+			butterworthHighpass(scaledFreq, order/2, design);
+			int half = size();
+			stages.resize(half*2);
+			for (int i = 0; i < half; ++i) stages[half + i].copyFrom(stages[i]);
+			return *this;
+		}
+		/// @}
+
+		/// @name Chebyshev (type I)
+		/// Equiripple passband, with the response at `scaledFreq` equal to `-rippleDb`.
+		/// @{
+		BiquadCascade & chebyshevLowpass(double scaledFreq, int order, double rippleDb=1, BiquadDesign design=BiquadDesign::bilinear) {
+			return designChebyshev(scaledFreq, order, rippleDb, false, design);
+		}
+		BiquadCascade & chebyshevHighpass(double scaledFreq, int order, double rippleDb=1, BiquadDesign design=BiquadDesign::bilinear) {
+			return designChebyshev(scaledFreq, order, rippleDb, true, design);
+		}
+		/// @}
+
+		/** Switches to (or from) the parallel form, resetting the state.
+		Returns `false` (and stays in cascade form) if the expansion isn't possible: when poles are repeated, or the numerator has a higher order than the denominator.*/
+		bool setParallel(bool enable=true) {
+			parallel = false;
+			parallelB0.clear();
+			parallelB1.clear();
+			parallelA1.clear();
+			parallelA2.clear();
+			if (!enable) {
+				reset();
+				return true;
+			}
+
+			using Complex = std::complex<double>;
+			// Everything is evaluated in factored form, which is much better-conditioned than multiplying out the polynomials
+			std::vector<Complex> poles;
+			int numeratorOrder = 0;
+			double numeratorLeading = 1;
+			for (auto &stage : stages) {
+				if (stage.a2 != 0) {
+					Complex root = std::sqrt(Complex(double(stage.a1)*stage.a1 - 4.0*stage.a2));
+					poles.push_back((-double(stage.a1) + root)*0.5);
+					poles.push_back((-double(stage.a1) - root)*0.5);
+				} else if (stage.a1 != 0) {
+					poles.push_back(-double(stage.a1));
+				}
+				if (stage.b2 != 0) {
+					numeratorOrder += 2;
+					numeratorLeading *= stage.b2;
+				} else if (stage.b1 != 0) {
+					numeratorOrder += 1;
+					numeratorLeading *= stage.b1;
+				} else {
+					numeratorLeading *= stage.b0;
+				}
+			}
+			int order = int(poles.size());
+			if (numeratorOrder > order) return false;
+			for (int i = 0; i < order; ++i) {
+				for (int j = 0; j < i; ++j) {
+					if (std::abs(poles[i] - poles[j]) < 1e-6) return false;
+				}
+			}
+
+			// Direct term is the limit as z^-1 -> infinity
+			double direct = 0;
+			if (numeratorOrder == order) {
+				Complex d = numeratorLeading;
+				for (auto &p : poles) d /= -p;
+				direct = d.real();
+			}
+			std::vector<Complex> residues(order);
+			for (int i = 0; i < order; ++i) {
+				Complex w = 1.0/poles[i], value = 1;
+				for (auto &stage : stages) {
+					value *= double(stage.b0) + w*(double(stage.b1) + w*double(stage.b2));
+				}
+				for (int j = 0; j < order; ++j) {
+					if (j != i) value /= (1.0 - poles[j]*w);
+				}
+				residues[i] = value;
+			}
+
+			// Pair up into real sections
+			auto addSection = [&](double b0, double b1, double a1, double a2) {
+				parallelB0.push_back(b0);
+				parallelB1.push_back(b1);
+				parallelA1.push_back(a1);
+				parallelA2.push_back(a2);
+			};
+			std::vector<bool> used(order, false);
+			int realPole = -1;
+			for (int i = 0; i < order; ++i) {
+				if (used[i]) continue;
+				used[i] = true;
+				Complex p = poles[i], r = residues[i];
+				if (std::abs(p.imag()) > 1e-12) {
+					// Find the conjugate
+					for (int j = i + 1; j < order; ++j) {
+						if (!used[j] && std::abs(poles[j] - std::conj(p)) < 1e-9) {
+							used[j] = true;
+							break;
+						}
+					}
+					addSection(2*r.real(), -2*(r*std::conj(p)).real(), -2*p.real(), std::norm(p));
+				} else if (realPole < 0) {
+					realPole = i;
+				} else {
+					double p1 = poles[realPole].real(), p2 = p.real();
+					double r1 = residues[realPole].real(), r2 = r.real();
+					addSection(r1 + r2, -(r1*p2 + r2*p1), -(p1 + p2), p1*p2);
+					realPole = -1;
+				}
+			}
+			if (realPole >= 0) {
+				addSection(residues[realPole].real(), 0, -poles[realPole].real(), 0);
+			}
+			parallelDirect = Sample(direct);
+			parallelY1.assign(parallelB0.size(), 0);
+			parallelY2.assign(parallelB0.size(), 0);
+			parallel = true;
+			reset();
+			return true;
+		}
+		bool isParallel() const {
+			return parallel;
+		}
+
+		Sample operator ()(Sample x) {
+			if (parallel) return processParallel(x);
+			for (auto &stage : stages) x = stage(x);
+			return x;
+		}
+
+		/// Processes a block of samples (which can be in-place), one section at a time
+		void process(const Sample *input, Sample *output, int length) {
+			if (parallel) {
+				for (int i = 0; i < length; ++i) {
+					output[i] = processParallel(input[i]);
+				}
+			} else if (stages.empty()) {
+				for (int i = 0; i < length; ++i) output[i] = input[i];
+			} else {
+				stages[0].process(input, output, length);
+				for (size_t s = 1; s < stages.size(); ++s) {
+					stages[s].process(output, length);
+				}
+			}
+		}
+		void process(Sample *data, int length) {
+			process(data, data, length);
+		}
+
+		std::complex<Sample> response(Sample scaledFreq) const {
+			std::complex<Sample> result = 1;
+			for (auto &stage : stages) result *= stage.response(scaledFreq);
+			return result;
+		}
+		Sample responseDb(Sample scaledFreq) const {
+			Sample db = 0;
+			for (auto &stage : stages) db += stage.responseDb(scaledFreq);
+			return db;
+		}
+
+		/// @name Batch responses (see `BiquadStatic::responses()`)
+		/// @{
+		void responsesLinear(Sample startFreq, Sample stepFreq, std::complex<Sample> *output, int count) const {
+			Biquad::responsesLinear(stages, size(), startFreq, stepFreq, output, count);
+		}
+		void responsesDbLinear(Sample startFreq, Sample stepFreq, Sample *outputDb, int count) const {
+			Biquad::responsesDbLinear(stages, size(), startFreq, stepFreq, outputDb, count);
+		}
+		void responses(const Sample *scaledFreqs, std::complex<Sample> *output, int count) const {
+			Biquad::responses(stages, size(), scaledFreqs, output, count);
+		}
+		void responsesDb(const Sample *scaledFreqs, Sample *outputDb, int count) const {
+			Biquad::responsesDb(stages, size(), scaledFreqs, outputDb, count);
+		}
+		/// @}
+	};
+
+	/** @brief Filters long signals with a `BiquadStatic`, split into chunks which can be processed on separate threads
+
+		Each chunk is first filtered independently, assuming zero output history.  The true output history at the start of each chunk is then found with a (cheap, serial) scan over the chunks, and each chunk is corrected by adding the zero-input response to that history.  By linearity, this gives the same result as filtering serially (up to rounding error).
+
+		This class doesn't create any threads itself.  `.process()` takes a `parallelFor(count, task)` callable, which must call `task(i)` for every `i` in `[0, count)` and return when they're all done:
+		\code
+			BiquadBlockParallel<float> blockParallel(8192);
+			blockParallel.copyFrom(BiquadStatic<float>().lowpass(0.01));
+			blockParallel.process(input, output, length, [&](int count, std::function<void(int)> task) {
+				// e.g. split across a thread pool
+			});
+		\endcode
+		The three stages are also available separately (`.processChunk()`, `.propagate()` and `.correctChunk()`).
+
+		Input and output must not overlap, since each chunk reads the input just before it.
+	*/
+	template<typename Sample>
+	class BiquadBlockParallel {
+		using Biquad = BiquadStatic<Sample>;
+		Biquad filter;
+		int chunkLength;
+		// Zero-input responses to y[-1] = 1 and y[-2] = 1, which are zero after `responseLength`
+		std::vector<Sample> response1, response2;
+		int responseLength = 0;
+		// Output history (y[-1], y[-2]) at the start of each chunk
+		std::vector<std::array<Sample, 2>> chunkStates;
+
+		struct SerialFor {
+			template<class Task>
+			void operator()(int count, Task &&task) const {
+				for (int i = 0; i < count; ++i) task(i);
+			}
+		};
+
+		void updateResponses() {
+			Sample a1 = filter.a1, a2 = filter.a2;
+			Sample h1y1 = 1, h1y2 = 0, h2y1 = 0, h2y2 = 1;
+			responseLength = chunkLength;
+			for (int i = 0; i < chunkLength; ++i) {
+				Sample h1 = -a1*h1y1 - a2*h1y2, h2 = -a1*h2y1 - a2*h2y2;
+				response1[i] = h1;
+				response2[i] = h2;
+				h1y2 = h1y1;
+				h1y1 = h1;
+				h2y2 = h2y1;
+				h2y1 = h2;
+				// Stop before it decays into denormals (which are very slow to add)
+				Sample limit = 1e-30;
+				if (std::abs(h1y1) + std::abs(h1y2) + std::abs(h2y1) + std::abs(h2y2) < limit) {
+					responseLength = i + 1;
+					break;
+				}
+			}
+			for (int i = responseLength; i < chunkLength; ++i) {
+				response1[i] = response2[i] = 0;
+			}
+		}
+	public:
+		BiquadBlockParallel(int chunkLength=8192) : chunkLength(std::max(chunkLength, 2)), response1(this->chunkLength), response2(this->chunkLength) {
+			updateResponses();
+		}
+
+		/// Copies the coefficients (but not state) from a filter
+		BiquadBlockParallel & copyFrom(const Biquad &other) {
+			filter.copyFrom(other);
+			updateResponses();
+			return *this;
+		}
+
+		void reset() {
+			filter.reset();
+		}
+
+		int chunkCount(int length) const {
+			return (length + chunkLength - 1)/chunkLength;
+		}
+
+		/// Stage 1 (any thread): filters one chunk, assuming zero output history
+		void processChunk(int index, const Sample *input, Sample *output, int length) {
+			int start = index*chunkLength, end = std::min(start + chunkLength, length);
+			if (start >= end) return;
+			Biquad chunkFilter;
+			chunkFilter.copyFrom(filter);
+			chunkFilter.x1 = (start >= 1) ? input[start - 1] : filter.x1;
+			chunkFilter.x2 = (start >= 2) ? input[start - 2] : (start == 1 ? filter.x1 : filter.x2);
+			chunkFilter.process(input + start, output + start, end - start);
+		}
+
+		/// Stage 2 (single thread): finds the output history for each chunk, and updates the filter state to the end of the signal
+		void propagate(const Sample *input, const Sample *output, int length) {
+			int count = chunkCount(length);
+			chunkStates.resize(count);
+			Sample y1 = filter.y1, y2 = filter.y2;
+			for (int c = 0; c < count; ++c) {
+				chunkStates[c] = {{y1, y2}};
+				int start = c*chunkLength, chunkEnd = std::min(chunkLength, length - start);
+				Sample newY1 = output[start + chunkEnd - 1] + y1*response1[chunkEnd - 1] + y2*response2[chunkEnd - 1];
+				Sample newY2 = (chunkEnd >= 2) ? output[start + chunkEnd - 2] + y1*response1[chunkEnd - 2] + y2*response2[chunkEnd - 2] : y1;
+				y1 = newY1;
+				y2 = newY2;
+			}
+			if (length >= 2) {
+				filter.x1 = input[length - 1];
+				filter.x2 = input[length - 2];
+			} else if (length == 1) {
+				filter.x2 = filter.x1;
+				filter.x1 = input[0];
+			}
+			filter.y1 = y1;
+			filter.y2 = y2;
+		}
+
+		/// Stage 3 (any thread): corrects one chunk, using its output history from `.propagate()`
+		void correctChunk(int index, Sample *output, int length) const {
+			int start = index*chunkLength, end = std::min(start + chunkLength, length);
+			if (start >= end) return;
+			Sample y1 = chunkStates[index][0], y2 = chunkStates[index][1];
+			Sample *chunk = output + start;
+			const Sample *r1 = response1.data(), *r2 = response2.data();
+			int correctLength = std::min(end - start, responseLength);
+			for (int i = 0; i < correctLength; ++i) {
+				chunk[i] += y1*r1[i] + y2*r2[i];
+			}
+		}
+
+		/// Runs all three stages, using `parallelFor(count, task)` for the first and last
+		template<class ParallelFor>
+		void process(const Sample *input, Sample *output, int length, ParallelFor &&parallelFor) {
+			int count = chunkCount(length);
+			parallelFor(count, [&](int index) {
+				processChunk(index, input, output, length);
+			});
+			propagate(input, output, length);
+			parallelFor(count, [&](int index) {
+				correctChunk(index, output, length);
+			});
+		}
+		/// Runs all three stages on the current thread
+		void process(const Sample *input, Sample *output, int length) {
+			process(input, output, length, SerialFor());
+		}
+	};
+
+	template<typename Sample, int channels, bool sharedCoefficients>
+	class SVFBank;
+
+	/** @brief A zero-delay-feedback state-variable filter (trapezoidal integration, as described by Andrew Simper / Vadim Zavalishin)
+
+		This has the same filter types and parameters as `BiquadStatic`, and (for the `bilinear`, `cookbook` and `oneSided` designs) the same frequency response.  `BiquadDesign::vicanek` falls back to `oneSided`.
+
+		Unlike `BiquadStatic`, it stays stable and well-behaved when the parameters are changed every sample.  Designing uses the same fast approximations as `BiquadStatic::lowpassQFast()` etc. for the Q-based methods, so is cheap enough to do per-sample:
+		\code
+			SVF<float> filter;
+			for (int i = 0; i < length; ++i) {
+				filter.lowpassQ(cutoff[i], 2);
+				output[i] = filter(input[i]);
+			}
+		\endcode
+	*/
+	template<typename Sample>
+	class SVF {
+		template<typename>
+		friend class SVF;
+		template<typename, int, bool>
+		friend class SVFBank;
+
+		using Designer = BiquadStatic<double>;
+		using FreqSpec = typename Designer::FreqSpec;
+		static constexpr BiquadDesign bwDesign = BiquadDesign::oneSided;
+
+		// g/k are only kept for `.response()`
+		Sample g = 0, k = 0;
+		Sample a1 = 1, a2 = 0, a3 = 0, m0 = 1, m1 = 0, m2 = 0;
+		Sample ic1 = 0, ic2 = 0;
+
+		SIGNALSMITH_INLINE static BiquadDesign svfDesign(BiquadDesign design) {
+			return (design == BiquadDesign::vicanek) ? BiquadDesign::oneSided : design;
+		}
+		SIGNALSMITH_INLINE static FreqSpec octaveSpec(double scaledFreq, double octaves, BiquadDesign design) {
+			return Designer::octaveSpec(scaledFreq, octaves, svfDesign(design));
+		}
+		SIGNALSMITH_INLINE static FreqSpec qSpec(double scaledFreq, double q, BiquadDesign design) {
+			return Designer::qSpec(scaledFreq, q, svfDesign(design), true);
+		}
+
+		// Output is `mix0*input + mix1*band + mix2*low`, where the band/low outputs have damping `dk` and the frequency is scaled by `gScale`
+		SIGNALSMITH_INLINE SVF & configure(const FreqSpec &spec, double gScale, double dk, double mix0, double mix1, double mix2) {
+			double dg = spec.sinW0/(1 + spec.cosW0)*gScale; // tan(w0/2)
+			double da1 = 1/(1 + dg*(dg + dk));
+			g = dg;
+			k = dk;
+			a1 = da1;
+			a2 = dg*da1;
+			a3 = dg*dg*da1;
+			m0 = mix0;
+			m1 = mix1;
+			m2 = mix2;
+			return *this;
+		}
+		SIGNALSMITH_INLINE SVF & configureLowpass(const FreqSpec &spec) {
+			return configure(spec, 1, 2*spec.inv2Q, 0, 0, 1);
+		}
+		SIGNALSMITH_INLINE SVF & configureHighpass(const FreqSpec &spec) {
+			double dk = 2*spec.inv2Q;
+			return configure(spec, 1, dk, 1, -dk, -1);
+		}
+		SIGNALSMITH_INLINE SVF & configureBandpass(const FreqSpec &spec) {
+			double dk = 2*spec.inv2Q;
+			return configure(spec, 1, dk, 0, dk, 0);
+		}
+		SIGNALSMITH_INLINE SVF & configureNotch(const FreqSpec &spec) {
+			double dk = 2*spec.inv2Q;
+			return configure(spec, 1, dk, 1, -dk, 0);
+		}
+		SIGNALSMITH_INLINE SVF & configureAllpass(const FreqSpec &spec) {
+			double dk = 2*spec.inv2Q;
+			return configure(spec, 1, dk, 1, -2*dk, 0);
+		}
+		SIGNALSMITH_INLINE SVF & configurePeak(const FreqSpec &spec, double sqrtGain) {
+			double A = sqrtGain, dk = 2*spec.inv2Q/A;
+			return configure(spec, 1, dk, 1, dk*(A*A - 1), 0);
+		}
+		SIGNALSMITH_INLINE SVF & configureLowShelf(const FreqSpec &spec, double sqrtGain) {
+			double A = sqrtGain, dk = 2*spec.inv2Q;
+			return configure(spec, 1/std::sqrt(A), dk, 1, dk*(A - 1), A*A - 1);
+		}
+		SIGNALSMITH_INLINE SVF & configureHighShelf(const FreqSpec &spec, double sqrtGain) {
+			double A = sqrtGain, dk = 2*spec.inv2Q;
+			return configure(spec, std::sqrt(A), dk, A*A, dk*(1 - A)*A, 1 - A*A);
+		}
+	public:
+		static constexpr double defaultQ = Designer::defaultQ;
+		static constexpr double defaultBandwidth = Designer::defaultBandwidth;
+
+		Sample operator ()(Sample v0) {
+			Sample v3 = v0 - ic2;
+			Sample v1 = a1*ic1 + a2*v3;
+			Sample v2 = ic2 + a2*ic1 + a3*v3;
+			ic1 = 2*v1 - ic1;
+			ic2 = 2*v2 - ic2;
+			return m0*v0 + m1*v1 + m2*v2;
+		}
+
+		/// Processes a block of samples, which can be in-place
+		void process(const Sample *input, Sample *output, int length) {
+			// Local copies, since `output` could alias our members
+			Sample la1 = a1, la2 = a2, la3 = a3, lm0 = m0, lm1 = m1, lm2 = m2;
+			Sample lic1 = ic1, lic2 = ic2;
+			for (int i = 0; i < length; ++i) {
+				Sample v0 = input[i];
+				Sample v3 = v0 - lic2;
+				Sample v1 = la1*lic1 + la2*v3;
+				Sample v2 = lic2 + la2*lic1 + la3*v3;
+				lic1 = 2*v1 - lic1;
+				lic2 = 2*v2 - lic2;
+				output[i] = lm0*v0 + lm1*v1 + lm2*v2;
+			}
+			ic1 = lic1;
+			ic2 = lic2;
+		}
+		/// Processes a block of samples in-place
+		void process(Sample *data, int length) {
+			process(data, data, length);
+		}
+
+		void reset() {
+			ic1 = ic2 = 0;
+		}
+
+		/// Copies the coefficients (but not state) from another filter
+		template<typename OtherSample>
+		void copyFrom(const SVF<OtherSample> &other) {
+			g = other.g;
+			k = other.k;
+			a1 = other.a1;
+			a2 = other.a2;
+			a3 = other.a3;
+			m0 = other.m0;
+			m1 = other.m1;
+			m2 = other.m2;
+		}
+
+		std::complex<Sample> response(Sample scaledFreq) const {
+			if (g == 0) return m0; // neutral
+			// Bilinear transform of the analog prototype
+			std::complex<Sample> s = {0, std::tan(Sample(M_PI)*std::min(scaledFreq, Sample(0.4999)))/g};
+			std::complex<Sample> denominator = s*s + s*k + Sample(1);
+			return m0 + (m1*s + m2)/denominator;
+		}
+		Sample responseDb(Sample scaledFreq) const {
+			return 10*std::log10(std::norm(response(scaledFreq)));
+		}
+
+		/// @name Lowpass
+		/// @{
+		SVF & lowpass(double scaledFreq, double octaves=defaultBandwidth, BiquadDesign design=BiquadDesign::bilinear) {
+			return configureLowpass(octaveSpec(scaledFreq, octaves, design));
+		}
+		SVF & lowpassQ(double scaledFreq, double q, BiquadDesign design=BiquadDesign::bilinear) {
+			return configureLowpass(qSpec(scaledFreq, q, design));
+		}
+		/// @}
+
+		/// @name Highpass
+		/// @{
+		SVF & highpass(double scaledFreq, double octaves=defaultBandwidth, BiquadDesign design=BiquadDesign::bilinear) {
+			return configureHighpass(octaveSpec(scaledFreq, octaves, design));
+		}
+		SVF & highpassQ(double scaledFreq, double q, BiquadDesign design=BiquadDesign::bilinear) {
+			return configureHighpass(qSpec(scaledFreq, q, design));
+		}
+		/// @}
+
+		/// @name Bandpass
+		/// @{
+		SVF & bandpass(double scaledFreq, double octaves=defaultBandwidth, BiquadDesign design=bwDesign) {
+			return configureBandpass(octaveSpec(scaledFreq, octaves, design));
+		}
+		SVF & bandpassQ(double scaledFreq, double q, BiquadDesign design=bwDesign) {
+			return configureBandpass(qSpec(scaledFreq, q, design));
+		}
+		/// @}
+
+		/// @name Notch
+		/// @{
+		SVF & notch(double scaledFreq, double octaves=defaultBandwidth, BiquadDesign design=bwDesign) {
+			return configureNotch(octaveSpec(scaledFreq, octaves, design));
+		}
+		SVF & notchQ(double scaledFreq, double q, BiquadDesign design=bwDesign) {
+			return configureNotch(qSpec(scaledFreq, q, design));
+		}
+		/// @}
+
+		/// @name Peak
+		/// @{
+		SVF & peak(double scaledFreq, double gain, double octaves=1, BiquadDesign design=bwDesign) {
+			return configurePeak(octaveSpec(scaledFreq, octaves, design), std::sqrt(gain));
+		}
+		SVF & peakDb(double scaledFreq, double db, double octaves=1, BiquadDesign design=bwDesign) {
+			return configurePeak(octaveSpec(scaledFreq, octaves, design), Designer::fastDbToSqrtGain(db));
+		}
+		SVF & peakQ(double scaledFreq, double gain, double q, BiquadDesign design=bwDesign) {
+			return configurePeak(qSpec(scaledFreq, q, design), std::sqrt(gain));
+		}
+		SVF & peakDbQ(double scaledFreq, double db, double q, BiquadDesign design=bwDesign) {
+			return configurePeak(qSpec(scaledFreq, q, design), Designer::fastDbToSqrtGain(db));
+		}
+		/// @}
+
+		/// @name High shelf
+		/// @{
+		SVF & highShelf(double scaledFreq, double gain, double octaves=defaultBandwidth, BiquadDesign design=bwDesign) {
+			return configureHighShelf(octaveSpec(scaledFreq, octaves, design), std::sqrt(gain));
+		}
+		SVF & highShelfDb(double scaledFreq, double db, double octaves=defaultBandwidth, BiquadDesign design=bwDesign) {
+			return configureHighShelf(octaveSpec(scaledFreq, octaves, design), Designer::fastDbToSqrtGain(db));
+		}
+		SVF & highShelfQ(double scaledFreq, double gain, double q, BiquadDesign design=bwDesign) {
+			return configureHighShelf(qSpec(scaledFreq, q, design), std::sqrt(gain));
+		}
+		SVF & highShelfDbQ(double scaledFreq, double db, double q, BiquadDesign design=bwDesign) {
+			return configureHighShelf(qSpec(scaledFreq, q, design), Designer::fastDbToSqrtGain(db));
+		}
+		/// @}
+
+		/// @name Low shelf
+		/// @{
+		SVF & lowShelf(double scaledFreq, double gain, double octaves=2, BiquadDesign design=bwDesign) {
+			return configureLowShelf(octaveSpec(scaledFreq, octaves, design), std::sqrt(gain));
+		}
+		SVF & lowShelfDb(double scaledFreq, double db, double octaves=2, BiquadDesign design=bwDesign) {
+			return configureLowShelf(octaveSpec(scaledFreq, octaves, design), Designer::fastDbToSqrtGain(db));
+		}
+		SVF & lowShelfQ(double scaledFreq, double gain, double q, BiquadDesign design=bwDesign) {
+			return configureLowShelf(qSpec(scaledFreq, q, design), std::sqrt(gain));
+		}
+		SVF & lowShelfDbQ(double scaledFreq, double db, double q, BiquadDesign design=bwDesign) {
+			return configureLowShelf(qSpec(scaledFreq, q, design), Designer::fastDbToSqrtGain(db));
+		}
+		/// @}
+
+		/// @name Allpass
+		/// @{
+		SVF & allpass(double scaledFreq, double octaves=1, BiquadDesign design=bwDesign) {
+			return configureAllpass(octaveSpec(scaledFreq, octaves, design));
+		}
+		SVF & allpassQ(double scaledFreq, double q, BiquadDesign design=bwDesign) {
+			return configureAllpass(qSpec(scaledFreq, q, design));
+		}
+		/// @}
+	};
+
+	/** @brief A bank of `SVF`s for a fixed number of channels, processed together
+
+		As with `BiquadBank`, coefficients and state are stored as separate arrays (one entry per channel) so that the per-channel loop can be vectorised.  Filters are designed using `SVF`, and then copied in (which is cheap enough to do every sample):
+		\code
+			SVFBank<float, 8> bank;
+			for (int c = 0; c < 8; ++c) {
+				bank.copyFrom(c, SVF<float>().lowpassQ(cutoff[c], 2));
+			}
+		\endcode
+	*/
+	template<typename Sample, int channels, bool sharedCoefficients=false>
+	class SVFBank {
+		static constexpr int coeffChannels = sharedCoefficients ? 1 : channels;
+		struct Coeffs {
+			std::array<Sample, coeffChannels> a1, a2, a3, m0, m1, m2;
+		} coeffs;
+		struct State {
+			std::array<Sample, channels> ic1, ic2;
+		} state;
+
+		template<class Filter>
+		void copyCoeffs(int c, const Filter &filter) {
+			coeffs.a1[c] = Sample(filter.a1);
+			coeffs.a2[c] = Sample(filter.a2);
+			coeffs.a3[c] = Sample(filter.a3);
+			coeffs.m0[c] = Sample(filter.m0);
+			coeffs.m1[c] = Sample(filter.m1);
+			coeffs.m2[c] = Sample(filter.m2);
+		}
+
+		SIGNALSMITH_INLINE static void processFrame(const Coeffs &k, State &s, const Sample *input, Sample *output) {
+			for (int c = 0; c < channels; ++c) {
+				int cc = sharedCoefficients ? 0 : c;
+				Sample v0 = input[c];
+				Sample v3 = v0 - s.ic2[c];
+				Sample v1 = k.a1[cc]*s.ic1[c] + k.a2[cc]*v3;
+				Sample v2 = s.ic2[c] + k.a2[cc]*s.ic1[c] + k.a3[cc]*v3;
+				s.ic1[c] = 2*v1 - s.ic1[c];
+				s.ic2[c] = 2*v2 - s.ic2[c];
+				output[c] = k.m0[cc]*v0 + k.m1[cc]*v1 + k.m2[cc]*v2;
+			}
+		}
+	public:
+		SVFBank() {
+			copyFrom(SVF<Sample>()); // neutral
+			reset();
+		}
+
+		void reset() {
+			for (int c = 0; c < channels; ++c) {
+				state.ic1[c] = state.ic2[c] = 0;
+			}
+		}
+
+		/// Copies coefficients (but not state) from an `SVF` into every channel
+		template<typename OtherSample>
+		SVFBank & copyFrom(const SVF<OtherSample> &filter) {
+			for (int c = 0; c < coeffChannels; ++c) {
+				copyCoeffs(c, filter);
+			}
+			return *this;
+		}
+		/// Copies coefficients (but not state) from an `SVF` into a single channel
+		template<typename OtherSample>
+		SVFBank & copyFrom(int channel, const SVF<OtherSample> &filter) {
+			static_assert(!sharedCoefficients, "can't set individual channels when coefficients are shared");
+			copyCoeffs(channel, filter);
+			return *this;
+		}
+
+		/// Processes a single multi-channel frame (can be in-place)
+		template<class Input, class Output>
+		void operator ()(Input &&input, Output &&output) {
+			std::array<Sample, channels> inFrame, outFrame;
+			for (int c = 0; c < channels; ++c) inFrame[c] = input[c];
+			processFrame(coeffs, state, inFrame.data(), outFrame.data());
+			for (int c = 0; c < channels; ++c) output[c] = outFrame[c];
+		}
+
+		/// Processes multi-channel data where `data[c][i]` is a sample (can be in-place)
+		template<class Input, class Output>
+		void process(Input &&input, Output &&output, int length) {
+			const Coeffs k = coeffs;
+			State s = state;
+			std::array<Sample, channels> inFrame, outFrame;
+			for (int i = 0; i < length; ++i) {
+				for (int c = 0; c < channels; ++c) inFrame[c] = input[c][i];
+				processFrame(k, s, inFrame.data(), outFrame.data());
+				for (int c = 0; c < channels; ++c) output[c][i] = outFrame[c];
+			}
+			state = s;
+		}
+
+		/// Processes interleaved (frame-major) data, where `data[i*channels + c]` is a sample (can be in-place)
+		void processInterleaved(const Sample *input, Sample *output, int length) {
+			const Coeffs k = coeffs;
+			State s = state;
+			for (int i = 0; i < length; ++i) {
+				processFrame(k, s, input + i*channels, output + i*channels);
+			}
+			state = s;
+		}
+		void processInterleaved(Sample *data, int length) {
+			processInterleaved(data, data, length);
+		}
+	};
+
+	/** @brief A multi-band Linkwitz-Riley crossover, with allpass compensation so that the bands sum to an allpass
+		\code
+			Crossover<float> crossover(2); // stereo
+			double splitFreqs[] = {100/sampleRate, 1000/sampleRate, 5000/sampleRate};
+			crossover.linkwitzRiley(splitFreqs, 3, 4); // 4 bands, 4th-order splits
+			// bands[b][c][i]
+			crossover.process(input, bands, length);
+		\endcode
+		The splits form a balanced tree, where each split filters the output of the one above it (so no band repeats its neighbours' filtering).  Each branch is compensated (with allpasses matching the splits on the other side of the tree) before it splits further, so the compensation is also shared.
+
+		All the branches at the same depth of the tree are stored side-by-side, with their coefficients and state as arrays, and updated together so the inner loop can be vectorised across bands.
+
+		The sum of the bands is the cascade of each split's allpass (so it has a flat magnitude response).  For orders which aren't multiples of 4, the highpass side of each split is inverted to make this work.
+
+		Designing allocates, but processing doesn't.
+	*/
+	template<typename Sample>
+	class Crossover {
+		using Biquad = BiquadStatic<Sample>;
+		static constexpr int chunkLength = 64;
+
+		// All the branches at one depth of the tree
+		struct Level {
+			int lanes = 0, sections = 0;
+			// The lane (in the level above) which each lane filters, or -1 for the input
+			std::vector<int> parents;
+			// Indexed by `[section*lanes + lane]`, padded with neutral sections
+			std::vector<Sample> a1, a2, b0, b1, b2;
+			// Indexed by `[(channel*sections + section)*lanes + lane]`
+			std::vector<Sample> x1, x2, y1, y2;
+			// Output for the current chunk, indexed by `[i*lanes + lane]`
+			std::vector<Sample> buffer;
+		};
+		std::vector<Level> levels;
+		// Which level/lane produces each band
+		std::vector<int> bandLevel, bandLane;
+		int channelCount;
+
+		struct Layout {
+			std::vector<double> splitFreqs;
+			int order;
+			// Section chains for each lane of each level
+			std::vector<std::vector<std::vector<Biquad>>> chains;
+			std::vector<std::vector<int>> parents;
+		};
+
+		// Linkwitz-Riley lowpass/highpass (two identical Butterworth filters)
+		static void appendLinkwitzRiley(std::vector<Biquad> &chain, double scaledFreq, int order, bool highpass) {
+			BiquadCascade<Sample> butterworth;
+			if (highpass) {
+				butterworth.butterworthHighpass(scaledFreq, order/2);
+			} else {
+				butterworth.butterworthLowpass(scaledFreq, order/2);
+			}
+			int start = int(chain.size());
+			for (int s = 0; s < butterworth.size(); ++s) chain.push_back(butterworth[s]);
+			for (int s = 0; s < butterworth.size(); ++s) chain.push_back(butterworth[s]);
+			if (highpass && (order/2)%2) {
+				Biquad &section = chain[start];
+				section.b0 = -section.b0;
+				section.b1 = -section.b1;
+				section.b2 = -section.b2;
+			}
+		}
+		// The allpass which a split's lowpass/highpass sum to: a Butterworth denominator, with the numerator reversed
+		static void appendAllpass(std::vector<Biquad> &chain, double scaledFreq, int order) {
+			BiquadCascade<Sample> butterworth;
+			butterworth.butterworthLowpass(scaledFreq, order/2);
+			for (int s = 0; s < butterworth.size(); ++s) {
+				Biquad section = butterworth[s];
+				bool firstOrder = (order/2)%2 && s == butterworth.size() - 1;
+				section.b0 = firstOrder ? section.a1 : section.a2;
+				section.b1 = firstOrder ? 1 : section.a1;
+				section.b2 = firstOrder ? 0 : 1;
+				chain.push_back(section);
+			}
+		}
+
+		// Adds a lane which produces bands `[start, end)`, and splits it further if there's more than one
+		void addLane(Layout &layout, int level, int parent, std::vector<Biquad> &&chain, int start, int end) {
+			if (int(layout.chains.size()) <= level) {
+				layout.chains.resize(level + 1);
+				layout.parents.resize(level + 1);
+			}
+			int lane = int(layout.chains[level].size());
+			layout.chains[level].push_back(std::move(chain));
+			layout.parents[level].push_back(parent);
+			if (end - start == 1) {
+				bandLevel[start] = level;
+				bandLane[start] = lane;
+			} else {
+				addSplit(layout, level + 1, lane, start, end);
+			}
+		}
+		void addSplit(Layout &layout, int level, int parent, int start, int end) {
+			int mid = (start + end)/2;
+			double splitFreq = layout.splitFreqs[mid - 1];
+			std::vector<Biquad> low, high;
+			appendLinkwitzRiley(low, splitFreq, layout.order, false);
+			appendLinkwitzRiley(high, splitFreq, layout.order, true);
+			// Each side is compensated for the splits on the other side
+			for (int s = mid; s < end - 1; ++s) appendAllpass(low, layout.splitFreqs[s], layout.order);
+			for (int s = start; s < mid - 1; ++s) appendAllpass(high, layout.splitFreqs[s], layout.order);
+			addLane(layout, level, parent, std::move(low), start, mid);
+			addLane(layout, level, parent, std::move(high), mid, end);
+		}
+
+		void design(std::vector<double> &&splitFreqs, int order) {
+			Layout layout;
+			layout.splitFreqs = std::move(splitFreqs);
+			layout.order = std::max(2, order - order%2);
+			int bandCount = int(layout.splitFreqs.size()) + 1;
+			bandLevel.assign(bandCount, 0);
+			bandLane.assign(bandCount, 0);
+			if (bandCount == 1) {
+				addLane(layout, 0, -1, {}, 0, 1);
+			} else {
+				addSplit(layout, 0, -1, 0, bandCount);
+			}
+
+			levels.resize(layout.chains.size());
+			for (size_t l = 0; l < levels.size(); ++l) {
+				Level &level = levels[l];
+				auto &chains = layout.chains[l];
+				level.lanes = int(chains.size());
+				level.sections = 0;
+				for (auto &chain : chains) level.sections = std::max(level.sections, int(chain.size()));
+				level.parents = layout.parents[l];
+
+				int coeffCount = level.sections*level.lanes;
+				level.a1.assign(coeffCount, 0);
+				level.a2.assign(coeffCount, 0);
+				level.b0.assign(coeffCount, 1);
+				level.b1.assign(coeffCount, 0);
+				level.b2.assign(coeffCount, 0);
+				for (int lane = 0; lane < level.lanes; ++lane) {
+					auto &chain = chains[lane];
+					for (size_t s = 0; s < chain.size(); ++s) {
+						int k = int(s)*level.lanes + lane;
+						level.a1[k] = chain[s].a1;
+						level.a2[k] = chain[s].a2;
+						level.b0[k] = chain[s].b0;
+						level.b1[k] = chain[s].b1;
+						level.b2[k] = chain[s].b2;
+					}
+				}
+				level.buffer.resize(chunkLength*level.lanes);
+			}
+			resizeState();
+		}
+
+		void resizeState() {
+			for (auto &level : levels) {
+				int stateCount = channelCount*level.sections*level.lanes;
+				level.x1.assign(stateCount, 0);
+				level.x2.assign(stateCount, 0);
+				level.y1.assign(stateCount, 0);
+				level.y2.assign(stateCount, 0);
+			}
+		}
+
+		SIGNALSMITH_INLINE static void processSection(Level &level, int channel, int section, int length) {
+			int lanes = level.lanes;
+			int k = section*lanes, state = (channel*level.sections + section)*lanes;
+			const Sample *a1 = &level.a1[k], *a2 = &level.a2[k], *b0 = &level.b0[k], *b1 = &level.b1[k], *b2 = &level.b2[k];
+			Sample *x1 = &level.x1[state], *x2 = &level.x2[state], *y1 = &level.y1[state], *y2 = &level.y2[state];
+			for (int i = 0; i < length; ++i) {
+				Sample *frame = &level.buffer[i*lanes];
+				for (int lane = 0; lane < lanes; ++lane) {
+					Sample x0 = frame[lane];
+					Sample y0 = x0*b0[lane] + x1[lane]*b1[lane] + x2[lane]*b2[lane] - y1[lane]*a1[lane] - y2[lane]*a2[lane];
+					y2[lane] = y1[lane];
+					y1[lane] = y0;
+					x2[lane] = x1[lane];
+					x1[lane] = x0;
+					frame[lane] = y0;
+				}
+			}
+		}
+	public:
+		/// Starts with a single (unfiltered) band
+		Crossover(int channels=1) : channelCount(channels) {
+			design({}, 4);
+		}
+
+		int bands() const {
+			return int(bandLevel.size());
+		}
+		int channels() const {
+			return channelCount;
+		}
+		/// Changes the number of channels (which allocates, and resets the state)
+		void resize(int channels) {
+			channelCount = channels;
+			resizeState();
+		}
+
+		void reset() {
+			for (auto &level : levels) {
+				for (auto &v : level.x1) v = 0;
+				for (auto &v : level.x2) v = 0;
+				for (auto &v : level.y1) v = 0;
+				for (auto &v : level.y2) v = 0;
+			}
+		}
+
+		/** Splits at each of the (ascending) frequencies in `scaledFreqs`, giving `splitCount + 1` bands.  The `order` is for each lowpass/highpass, so must be even.
+		This allocates, and resets the state.*/
+		template<class Freqs>
+		Crossover & linkwitzRiley(Freqs &&scaledFreqs, int splitCount, int order=4) {
+			std::vector<double> splitFreqs(splitCount);
+			for (int s = 0; s < splitCount; ++s) splitFreqs[s] = scaledFreqs[s];
+			design(std::move(splitFreqs), order);
+			return *this;
+		}
+
+		/** Splits multi-channel input (`input[c][i]`) into bands (`bands[b][c][i]`).
+		This can be in-place for one band (i.e. `bands[b][c]` can be the same as `input[c]`).*/
+		template<class Input, class Bands>
+		void process(Input &&input, Bands &&bands, int length) {
+			int bandCount = this->bands();
+			for (int c = 0; c < channelCount; ++c) {
+				for (int start = 0; start < length; start += chunkLength) {
+					int count = std::min(int(chunkLength), length - start);
+					for (size_t l = 0; l < levels.size(); ++l) {
+						Level &level = levels[l];
+						int lanes = level.lanes;
+						for (int lane = 0; lane < lanes; ++lane) {
+							int parent = level.parents[lane];
+							if (parent < 0) {
+								auto &&channel = input[c];
+								for (int i = 0; i < count; ++i) level.buffer[i*lanes + lane] = channel[start + i];
+							} else {
+								const Level &above = levels[l - 1];
+								for (int i = 0; i < count; ++i) level.buffer[i*lanes + lane] = above.buffer[i*above.lanes + parent];
+							}
+						}
+						for (int s = 0; s < level.sections; ++s) {
+							processSection(level, c, s, count);
+						}
+					}
+					for (int b = 0; b < bandCount; ++b) {
+						const Level &level = levels[bandLevel[b]];
+						int lanes = level.lanes, lane = bandLane[b];
+						auto &&output = bands[b][c];
+						for (int i = 0; i < count; ++i) output[start + i] = level.buffer[i*lanes + lane];
+					}
+				}
+			}
+		}
+
+		/// Frequency response of a single band
+		std::complex<Sample> response(int band, Sample scaledFreq) const {
+			Sample w = scaledFreq*Sample(2*M_PI);
+			std::complex<Sample> invZ = {std::cos(w), -std::sin(w)}, invZ2 = invZ*invZ;
+			std::complex<Sample> result = 1;
+			int lane = bandLane[band];
+			for (int l = bandLevel[band]; l >= 0; --l) {
+				const Level &level = levels[l];
+				for (int s = 0; s < level.sections; ++s) {
+					int k = s*level.lanes + lane;
+					result *= (level.b0[k] + level.b1[k]*invZ + level.b2[k]*invZ2)/(Sample(1) + level.a1[k]*invZ + level.a2[k]*invZ2);
+				}
+				lane = level.parents[lane];
+			}
+			return result;
+		}
+		Sample responseDb(int band, Sample scaledFreq) const {
+			return 10*std::log10(std::norm(response(band, scaledFreq)));
+		}
+	};
+
 	/** @} */
 }} // signalsmith::filters::
 #endif // include guard
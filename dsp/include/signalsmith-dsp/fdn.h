@@ -0,0 +1 @@
+#include "../../fdn.h"
@@ -0,0 +1 @@
+#include "../../loudness.h"
@@ -0,0 +1,196 @@
+#include "./common.h"
+
+#ifndef SIGNALSMITH_DSP_LOUDNESS_H
+#define SIGNALSMITH_DSP_LOUDNESS_H
+
+#include "./filters.h"
+#include "./envelopes.h"
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+
+namespace signalsmith {
+namespace loudness {
+	/**	@defgroup Loudness Loudness metering
+		@brief ITU-R BS.1770 / EBU R128 loudness (LUFS)
+
+		@{
+		@file
+	*/
+
+	/** ITU-R BS.1770 loudness meter, with momentary (400ms), short-term (3s) and gated integrated loudness.
+		\code
+			LoudnessMeter<> meter(channels, sampleRate);
+			meter.setWeight(3, 0); // e.g. ignore the LFE channel
+			meter.process(input, length); // input[c][i]
+			double lufs = meter.integrated();
+		\endcode
+		Each channel is K-weighted (a high-shelf and a highpass, as `filters::BiquadStatic`), and the weighted energies are summed into an `envelopes::BoxSum` which is read at both window lengths.
+
+		The integrated loudness uses overlapping 400ms gating blocks, every 100ms.  Instead of storing every block's energy, each block is added to a histogram of 0.1dB bins (between -70 and +30 LUFS), which keeps the count and total energy for each bin.  This means memory is constant and each block is O(1), so it can run over streams of any length.  The absolute gate (-70 LUFS) is exact.  For the relative gate, blocks in the bin which contains it are assumed to be spread evenly across that bin.
+
+		The filters run with `Sample` precision, which should be `double` unless you're confident in `float` at your sample-rate (the highpass poles are very close to 1).
+	*/
+	template<typename Sample=double>
+	class LoudnessMeter {
+		static constexpr int chunkLength = 256;
+		static constexpr double absoluteGate = -70, relativeGate = -10;
+		static constexpr double histogramMin = -70, histogramMax = 30, histogramStep = 0.1;
+		static constexpr int histogramBins = 1000; // (max - min)/step
+
+		struct Bin {
+			double energy = 0;
+			uint64_t count = 0;
+		};
+
+		int channels = 0;
+		std::vector<signalsmith::filters::BiquadStatic<Sample>> shelves, highpasses;
+		std::vector<double> weights;
+		signalsmith::envelopes::BoxSum<double> energySum{0};
+		int momentaryLength = 0, shortTermLength = 0, blockStep = 0, untilBlock = 0;
+		std::vector<Sample> filtered;
+		std::vector<double> energy, momentarySums;
+		std::vector<Bin> histogram;
+		double absoluteGateEnergy = lufsToEnergy(absoluteGate);
+
+		static double energyToLufs(double meanSquare) {
+			if (meanSquare <= 0) return -std::numeric_limits<double>::infinity();
+			return -0.691 + 10*std::log10(meanSquare);
+		}
+		static double lufsToEnergy(double lufs) {
+			return std::pow(10, (lufs + 0.691)*0.1);
+		}
+
+		void addBlock(double meanSquare) {
+			if (meanSquare < absoluteGateEnergy) return;
+			int bin = int((energyToLufs(meanSquare) - histogramMin)/histogramStep);
+			bin = std::min(bin, histogramBins - 1);
+			histogram[bin].energy += meanSquare;
+			++histogram[bin].count;
+		}
+	public:
+		LoudnessMeter(int channels=0, double sampleRate=48000) {
+			configure(channels, sampleRate);
+		}
+
+		/// Sets up the filters and windows for a given channel-count and sample-rate (and resets)
+		void configure(int nChannels, double sampleRate) {
+			channels = nChannels;
+			shelves.resize(channels);
+			highpasses.resize(channels);
+			weights.assign(channels, 1);
+
+			// The BS.1770 pre-filter has fixed poles, so the RBJ shelf's centre is lowered to match them
+			double shelfDb = 3.999843853973347, shelfQ = 0.7071752369554196;
+			double shelfK = std::tan(M_PI*1681.974450955533/sampleRate);
+			double shelfFreq = std::atan(shelfK*std::pow(10, -shelfDb/80))/M_PI;
+			// The RLB highpass has an un-normalised numerator (1, -2, 1)
+			double highpassFreq = 38.13547087602444/sampleRate, highpassQ = 0.5003270373238773;
+			double highpassK = std::tan(M_PI*highpassFreq);
+			double highpassGain = 1 + highpassK/highpassQ + highpassK*highpassK;
+			for (int c = 0; c < channels; ++c) {
+				shelves[c].highShelfDbQ(shelfFreq, shelfDb, shelfQ, signalsmith::filters::BiquadDesign::bilinear);
+				highpasses[c].highpassQ(highpassFreq, highpassQ, signalsmith::filters::BiquadDesign::bilinear).addGain(highpassGain);
+			}
+
+			blockStep = std::max(1, int(std::round(sampleRate*0.1)));
+			momentaryLength = blockStep*4;
+			shortTermLength = blockStep*30;
+			energySum.resize(shortTermLength);
+			filtered.resize(chunkLength);
+			energy.resize(chunkLength);
+			momentarySums.resize(chunkLength);
+			histogram.resize(histogramBins);
+			reset();
+		}
+
+		/// Weight for a channel's energy: BS.1770 uses 1 for front channels, 1.41 for surround, and 0 for LFE
+		void setWeight(int channel, double weight) {
+			weights[channel] = weight;
+		}
+
+		void reset() {
+			for (auto &filter : shelves) filter.reset();
+			for (auto &filter : highpasses) filter.reset();
+			energySum.reset();
+			untilBlock = momentaryLength;
+			resetIntegrated();
+		}
+		/// Clears the integrated loudness, without affecting the momentary/short-term windows
+		void resetIntegrated() {
+			histogram.assign(histogram.size(), Bin());
+		}
+
+		/// Processes a block of multi-channel input (`input[c][i]`)
+		template<class Input>
+		void process(Input &&input, int length) {
+			for (int start = 0; start < length; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), length - start);
+				for (int i = 0; i < chunk; ++i) energy[i] = 0;
+				for (int c = 0; c < channels; ++c) {
+					double weight = weights[c];
+					if (weight == 0) continue;
+					auto &&inputChannel = input[c];
+					for (int i = 0; i < chunk; ++i) filtered[i] = inputChannel[start + i];
+					shelves[c].process(filtered.data(), chunk);
+					highpasses[c].process(filtered.data(), chunk);
+					for (int i = 0; i < chunk; ++i) {
+						double v = filtered[i];
+						energy[i] += v*v*weight;
+					}
+				}
+				energySum.process(energy.data(), momentarySums.data(), chunk, momentaryLength);
+
+				// Gating blocks every 100ms (once the first 400ms window is full)
+				double momentaryScale = 1.0/momentaryLength;
+				int i = untilBlock - 1;
+				for (; i < chunk; i += blockStep) {
+					addBlock(momentarySums[i]*momentaryScale);
+				}
+				untilBlock = i + 1 - chunk;
+			}
+		}
+
+		/// Loudness over the last 400ms
+		double momentary() {
+			return energyToLufs(energySum.read(momentaryLength)/momentaryLength);
+		}
+		/// Loudness over the last 3s
+		double shortTerm() {
+			return energyToLufs(energySum.read(shortTermLength)/shortTermLength);
+		}
+		/// Gated loudness since the last `.reset()`/`.resetIntegrated()`
+		double integrated() const {
+			double totalEnergy = 0;
+			uint64_t totalCount = 0;
+			for (auto &bin : histogram) {
+				totalEnergy += bin.energy;
+				totalCount += bin.count;
+			}
+			if (totalCount == 0) return -std::numeric_limits<double>::infinity();
+
+			// Bins above the relative gate, plus part of the bin containing it (assuming the blocks are spread evenly across that bin)
+			double gate = energyToLufs(totalEnergy/totalCount) + relativeGate;
+			double gateBin = std::max(0.0, (gate - histogramMin)/histogramStep);
+			int firstBin = int(gateBin) + 1;
+			double gatedEnergy = 0, gatedCount = 0;
+			if (firstBin <= histogramBins) {
+				double fraction = firstBin - gateBin;
+				gatedEnergy = histogram[firstBin - 1].energy*fraction;
+				gatedCount = histogram[firstBin - 1].count*fraction;
+			}
+			for (int b = firstBin; b < histogramBins; ++b) {
+				gatedEnergy += histogram[b].energy;
+				gatedCount += histogram[b].count;
+			}
+			if (gatedCount <= 0) return -std::numeric_limits<double>::infinity();
+			return energyToLufs(gatedEnergy/gatedCount);
+		}
+	};
+
+/** @} */
+}} // signalsmith::loudness::
+#endif // include guard
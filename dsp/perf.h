@@ -4,11 +4,13 @@
 #define SIGNALSMITH_DSP_PERF_H
 
 #include <complex>
+#include <cstddef>
+#include <cstdint> // for uintptr_t
+#include <new> // for std::bad_alloc
+#include <type_traits>
 
 #if defined(__SSE__) || defined(_M_X64)
 #	include <xmmintrin.h>
-#else
-#	include <cstdint> // for uintptr_t
 #endif
 
 namespace signalsmith {
@@ -78,6 +80,85 @@ namespace perf {
 	class StopDenormals {}; // FIXME: add for other architectures
 #endif
 
+	/** @brief Hands out memory in order from a fixed external block, for use with `ArenaAllocator`
+
+		This lets a host place all the DSP state in one pre-allocated region, so the memory use is deterministic and nothing touches the system allocator after setup.  Classes with an `Allocator` template argument (`delay::Buffer`, `delay::MultiBuffer`, `envelopes::PeakHold`, `envelopes::BoxSum`, `spectral::STFT`, `rates::Oversampler2xFIR` and their wrappers) take an allocator instance as their last constructor argument:
+		\code
+			alignas(64) static char memory[1<<20];
+			signalsmith::perf::Arena arena(memory, sizeof(memory), 64);
+			using Allocator = signalsmith::perf::ArenaAllocator<float>;
+
+			signalsmith::delay::Buffer<float, signalsmith::delay::StorageNative, Allocator> buffer(48000, arena);
+			signalsmith::envelopes::PeakHold<float, Allocator> peakHold(256, arena);
+		\endcode
+
+		Individual allocations are never freed (only the whole arena, with `.reset()`), so size everything once during setup: resizing an object repeatedly will use up the arena.  When there's not enough space left, it throws `std::bad_alloc` like the default allocator.
+
+		Every allocation is aligned to at least `alignment` bytes (e.g. 64 for cache-lines or wide SIMD).  The `Arena` is not thread-safe, so use one per thread if setting up from several threads.
+	*/
+	class Arena {
+		char *start, *end, *next;
+		size_t alignment;
+	public:
+		Arena(void *memory, size_t bytes, size_t alignment=alignof(std::max_align_t)) : start((char *)memory), end(start + bytes), next(start), alignment(alignment) {}
+		// Copies would hand out the same memory twice
+		Arena(const Arena &other) = delete;
+		Arena & operator =(const Arena &other) = delete;
+
+		void * allocate(size_t bytes, size_t align=1) {
+			if (align < alignment) align = alignment;
+			uintptr_t address = (uintptr_t(next) + (align - 1))&~uintptr_t(align - 1);
+			if (address < uintptr_t(next) || address > uintptr_t(end) || bytes > uintptr_t(end) - address) {
+				throw std::bad_alloc();
+			}
+			next = (char *)address + bytes;
+			return (void *)address;
+		}
+		
+		/// Bytes used so far (including alignment padding)
+		size_t used() const {
+			return size_t(next - start);
+		}
+		size_t capacity() const {
+			return size_t(end - start);
+		}
+		/// Makes the whole arena available again - everything allocated from it must have been destroyed (or will not be used again)
+		void reset() {
+			next = start;
+		}
+	};
+
+	/** @brief A standard-compatible allocator, taking memory from an `Arena`
+		Deallocation does nothing, since the `Arena` only frees everything at once.  Allocators are equal if they use the same `Arena`.
+	*/
+	template<typename T>
+	struct ArenaAllocator {
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		Arena *arena;
+		
+		ArenaAllocator(Arena &arena) : arena(&arena) {}
+		template<typename Other>
+		ArenaAllocator(const ArenaAllocator<Other> &other) : arena(other.arena) {}
+
+		T * allocate(size_t n) {
+			return (T *)arena->allocate(n*sizeof(T), alignof(T));
+		}
+		void deallocate(T *, size_t) {}
+
+		template<typename Other>
+		bool operator ==(const ArenaAllocator<Other> &other) const {
+			return arena == other.arena;
+		}
+		template<typename Other>
+		bool operator !=(const ArenaAllocator<Other> &other) const {
+			return arena != other.arena;
+		}
+	};
+
 /** @} */
 }} // signalsmith::perf::
 
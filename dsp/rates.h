@@ -68,11 +68,13 @@ namespace rates {
 
 		\diagram{rates-oversampler2xfir-lengths.svg,Resample error rates for different passband thresholds}
 	
-		Since both upsample and downsample are stateful, channels are meaningful.  If your input channel-count doesn't match your output, you can size it to the larger of the two, and use `.upChannel()` and `.downChannel()` to only process the channels which exist.*/
-	template<typename Sample>
+		Since both upsample and downsample are stateful, channels are meaningful.  If your input channel-count doesn't match your output, you can size it to the larger of the two, and use `.upChannel()` and `.downChannel()` to only process the channels which exist.
+
+		The internal buffers are taken from `Allocator` (e.g. `perf::ArenaAllocator`), passed as the last constructor argument.*/
+	template<typename Sample, class Allocator=std::allocator<Sample>>
 	struct Oversampler2xFIR {
 		Oversampler2xFIR() : Oversampler2xFIR(0, 0) {}
-		Oversampler2xFIR(int channels, int maxBlock, int halfLatency=16, double passFreq=0.43) {
+		Oversampler2xFIR(int channels, int maxBlock, int halfLatency=16, double passFreq=0.43, const Allocator &allocator=Allocator()) : inputBuffer(allocator), halfSampleKernel(allocator), buffer(allocator), oddBuffer(allocator) {
 			resize(channels, maxBlock, halfLatency, passFreq);
 		}
 		
@@ -85,10 +87,13 @@ namespace rates {
 			channels = nChannels;
 			halfSampleKernel.resize(kernelLength);
 			fillKaiserSinc(halfSampleKernel, kernelLength, passFreq, 1 - passFreq);
+			// The kernel is symmetric, so we only need the first half
+			halfSampleKernel.resize(oneWayLatency);
 			inputStride = kernelLength + maxBlockLength;
 			inputBuffer.resize(channels*inputStride);
 			stride = (maxBlockLength + kernelLength)*2;
 			buffer.resize(stride*channels);
+			oddBuffer.resize(chunkLength + kernelLength);
 		}
 
 		void reset() {
@@ -118,14 +123,14 @@ namespace rates {
 				inputChannel[kernelLength + i] = data[i];
 			}
 			Sample *output = (*this)[c];
-			for (int i = 0; i < lowSamples; ++i) {
-				output[2*i] = inputChannel[i + oneWayLatency];
-				Sample *offsetInput = inputChannel + (i + 1);
-				Sample sum = 0;
-				for (int o = 0; o < kernelLength; ++o) {
-					sum += offsetInput[o]*halfSampleKernel[o];
+			for (int start = 0; start < lowSamples; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), lowSamples - start);
+				Sample sums[chunkLength];
+				symmetricFir(inputChannel + start + 1, sums, chunk);
+				for (int i = 0; i < chunk; ++i) {
+					output[2*(start + i)] = inputChannel[start + i + oneWayLatency];
+					output[2*(start + i) + 1] = sums[i];
 				}
-				output[2*i + 1] = sum;
 			}
 			// Copy the end of the buffer back to the beginning
 			for (int i = 0; i < kernelLength; ++i) {
@@ -145,16 +150,17 @@ namespace rates {
 		template<class Data>
 		void downChannel(int c, Data &&data, int lowSamples) {
 			Sample *input = buffer.data() + c*stride; // no offset for latency
-			for (int i = 0; i < lowSamples; ++i) {
-				Sample v1 = input[2*i + kernelLength];
-				Sample sum = 0;
-				for (int o = 0; o < kernelLength; ++o) {
-					Sample v2 = input[2*(i + o) + 1];
-					sum += v2*halfSampleKernel[o];
+			Sample *odd = oddBuffer.data();
+			for (int start = 0; start < lowSamples; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), lowSamples - start);
+				// The odd (half-sample) inputs, made contiguous
+				for (int i = 0; i < chunk + kernelLength - 1; ++i) odd[i] = input[2*(start + i) + 1];
+				Sample sums[chunkLength];
+				symmetricFir(odd, sums, chunk);
+				for (int i = 0; i < chunk; ++i) {
+					Sample v1 = input[2*(start + i) + kernelLength];
+					data[start + i] = (v1 + sums[i])*Sample(0.5);
 				}
-				Sample v2 = sum;
-				Sample v = (v1 + v2)*Sample(0.5);
-				data[i] = v;
 			}
 			// Copy the end of the buffer back to the beginning
 			for (int i = 0; i < kernelLength*2; ++i) {
@@ -171,12 +177,151 @@ namespace rates {
 		}
 
 	private:
+		static constexpr int chunkLength = 64;
 		int oneWayLatency, kernelLength;
 		int channels;
 		int stride, inputStride;
-		std::vector<Sample> inputBuffer;
-		std::vector<Sample> halfSampleKernel;
-		std::vector<Sample> buffer;
+		std::vector<Sample, Allocator> inputBuffer;
+		std::vector<Sample, Allocator> halfSampleKernel;
+		std::vector<Sample, Allocator> buffer;
+		std::vector<Sample, Allocator> oddBuffer;
+
+		/* `output[i]` is the half-sample kernel applied to `input[i]` to `input[i + kernelLength - 1]`.
+		Mirrored pairs of input are added before multiplying (since the kernel is symmetric), and each tap runs across the whole chunk, so the inner loop vectorises without re-ordering a sum. */
+		void symmetricFir(const Sample *input, Sample *output, int chunk) const {
+			for (int i = 0; i < chunk; ++i) output[i] = 0;
+			for (int o = 0; o < oneWayLatency; ++o) {
+				Sample k = halfSampleKernel[o];
+				const Sample *inputA = input + o, *inputB = input + (kernelLength - 1 - o);
+				for (int i = 0; i < chunk; ++i) {
+					output[i] += (inputA[i] + inputB[i])*k;
+				}
+			}
+		}
+	};
+
+	/** 4x oversampled true-peak detector (as used for ITU-R BS.1770 / EBU R128 true-peak metering).
+
+		Only the three fractional polyphase branches of the 4x interpolation filter are evaluated (the fourth is the input itself), and the maximum is taken straight away, so the oversampled signal is never stored.
+		\code{.cpp}
+			TruePeak<float> truePeak(channels);
+			// Per-sample true-peak (absolute) values, delayed by `.latency()`
+			truePeak.process(inputBuffers, outputBuffers, length);
+			// ... or just the maximum since the last `.resetPeaks()`
+			truePeak.process(inputBuffers, length);
+			float peak = truePeak.peak(c);
+		\endcode
+		The filter is a Kaiser-windowed sinc, with the same length/passband parameters as `Oversampler2xFIR`.  Each branch is a short FIR, computed tap-by-tap across a chunk of samples so that it vectorises without needing `-ffast-math`.*/
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	struct TruePeak {
+		TruePeak(int channels=0, int halfLatency=12, double passFreq=0.45, const Allocator &allocator=Allocator()) : branchKernels(allocator), inputBuffer(allocator), peaks(allocator) {
+			resize(channels, halfLatency, passFreq);
+		}
+
+		void resize(int nChannels, int halfLatency=12, double passFreq=0.45) {
+			channels = nChannels;
+			oneWayLatency = halfLatency;
+			branchLength = halfLatency*2;
+			// Kernel at the 4x rate, centred so that every 4th sample lands on an input sample
+			std::vector<double> kernel(branchLength*4 + 1);
+			fillKaiserSinc(kernel, int(kernel.size()), passFreq*0.25, (1 - passFreq)*0.25);
+			branchKernels.resize(branchLength*3);
+			for (int b = 0; b < 3; ++b) {
+				for (int i = 0; i < branchLength; ++i) {
+					branchKernels[b*branchLength + i] = Sample(kernel[4*i + b + 1]*4);
+				}
+			}
+			inputStride = branchLength + chunkLength;
+			inputBuffer.resize(channels*inputStride);
+			peaks.resize(channels);
+			reset();
+		}
+
+		void reset() {
+			inputBuffer.assign(inputBuffer.size(), 0);
+			resetPeaks();
+		}
+		/// Clears the maximum values returned by `.peak()`
+		void resetPeaks() {
+			peaks.assign(peaks.size(), 0);
+		}
+
+		/// Delay (at the input rate) of the per-sample output
+		int latency() const {
+			return oneWayLatency;
+		}
+
+		/// The maximum true-peak (absolute) value for a channel, since the last `.reset()`/`.resetPeaks()`
+		Sample peak(int c) const {
+			return peaks[c];
+		}
+
+		/// Processes multi-channel input (`input[c][i]`), only updating the values returned by `.peak()`
+		template<class Input>
+		void process(Input &&input, int length) {
+			for (int c = 0; c < channels; ++c) {
+				processChannel(c, input[c], [](int, Sample) {}, length);
+			}
+		}
+		/// Processes multi-channel input, writing the true-peak for each input sample (the maximum absolute value of it and the three following interpolated points) to `output[c][i]`
+		template<class Input, class Output>
+		void process(Input &&input, Output &&output, int length) {
+			for (int c = 0; c < channels; ++c) {
+				auto &&outputChannel = output[c];
+				processChannel(c, input[c], [&](int i, Sample v) {
+					outputChannel[i] = v;
+				}, length);
+			}
+		}
+
+	private:
+		static constexpr int chunkLength = 64;
+		int channels, oneWayLatency, branchLength;
+		int inputStride;
+		std::vector<Sample, Allocator> branchKernels;
+		std::vector<Sample, Allocator> inputBuffer;
+		std::vector<Sample, Allocator> peaks;
+
+		template<class Input, class OutputFn>
+		void processChannel(int c, Input &&input, OutputFn &&outputFn, int length) {
+			Sample *history = inputBuffer.data() + c*inputStride;
+			Sample *chunkInput = history + branchLength;
+			// Element-wise maximums, only combined at the end (a running maximum doesn't vectorise)
+			Sample chunkPeaks[chunkLength];
+			for (int i = 0; i < chunkLength; ++i) chunkPeaks[i] = 0;
+			for (int start = 0; start < length; start += chunkLength) {
+				int chunk = std::min(int(chunkLength), length - start);
+				for (int i = 0; i < chunk; ++i) chunkInput[i] = input[start + i];
+
+				Sample sum1[chunkLength], sum2[chunkLength], sum3[chunkLength];
+				for (int i = 0; i < chunk; ++i) sum1[i] = sum2[i] = sum3[i] = 0;
+				const Sample *kernel1 = branchKernels.data(), *kernel2 = kernel1 + branchLength, *kernel3 = kernel2 + branchLength;
+				for (int t = 0; t < branchLength; ++t) {
+					const Sample *tapInput = chunkInput - t; // the newest tap is the current input
+					Sample k1 = kernel1[t], k2 = kernel2[t], k3 = kernel3[t];
+					for (int i = 0; i < chunk; ++i) {
+						Sample x = tapInput[i];
+						sum1[i] += x*k1;
+						sum2[i] += x*k2;
+						sum3[i] += x*k3;
+					}
+				}
+
+				const Sample *delayed = chunkInput - oneWayLatency;
+				for (int i = 0; i < chunk; ++i) {
+					Sample v = std::max(std::max(std::abs(delayed[i]), std::abs(sum1[i])), std::max(std::abs(sum2[i]), std::abs(sum3[i])));
+					sum1[i] = v;
+					chunkPeaks[i] = std::max(chunkPeaks[i], v);
+				}
+				for (int i = 0; i < chunk; ++i) outputFn(start + i, sum1[i]);
+
+				// Keep the most recent input as history
+				for (int i = 0; i < branchLength; ++i) history[i] = history[chunk + i];
+			}
+			Sample maxPeak = peaks[c];
+			for (int i = 0; i < chunkLength; ++i) maxPeak = std::max(maxPeak, chunkPeaks[i]);
+			peaks[c] = maxPeak;
+		}
 	};
 
 /** @} */
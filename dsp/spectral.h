@@ -167,22 +167,26 @@ namespace spectral {
 		\endcode
 		
 		The index passed to this functor will be greater than the previous valid index, and `<=` the index you pass in.  Therefore, if you call `.ensureValid()` every sample, it can only ever be `0`.
+
+		The output buffer, spectrum and working buffer are taken from `Allocator` (e.g. `perf::ArenaAllocator`), passed as the last constructor argument.  The FFT's own setup (window, twiddles and permutation tables) still uses the default allocator.
 	*/
-	template<typename Sample>
-	class STFT : public signalsmith::delay::MultiBuffer<Sample> {
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	class STFT : public signalsmith::delay::MultiBuffer<Sample, false, signalsmith::delay::StorageNative, Allocator> {
 
-		using Super = signalsmith::delay::MultiBuffer<Sample>;
+		using Super = signalsmith::delay::MultiBuffer<Sample, false, signalsmith::delay::StorageNative, Allocator>;
 		using Complex = std::complex<Sample>;
+		using ComplexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Complex>;
 
 		int channels = 0, _windowSize = 0, _fftSize = 0, _interval = 1;
 		int validUntilIndex = 0;
 
 		class MultiSpectrum {
 			int channels, stride;
-			std::vector<Complex> buffer;
+			std::vector<Complex, ComplexAllocator> buffer;
 		public:
 			MultiSpectrum() : MultiSpectrum(0, 0) {}
 			MultiSpectrum(int channels, int bands) : channels(channels), stride(bands), buffer(channels*bands, 0) {}
+			MultiSpectrum(const Allocator &allocator) : channels(0), stride(0), buffer(ComplexAllocator(allocator)) {}
 			
 			void resize(int nChannels, int nBands) {
 				channels = nChannels;
@@ -206,7 +210,7 @@ namespace spectral {
 				return buffer.data() + channel*stride;
 			}
 		};
-		std::vector<Sample> timeBuffer;
+		std::vector<Sample, Allocator> timeBuffer;
 
 		bool rotate = false;
 		void resizeInternal(int newChannels, int windowSize, int newInterval, int historyLength, int zeroPadding) {
@@ -270,9 +274,10 @@ namespace spectral {
 		Spectrum spectrum;
 		WindowedFFT<Sample> fft;
 		
-		STFT() {}
+		STFT() : STFT(Allocator()) {}
+		explicit STFT(const Allocator &allocator) : Super(0, 0, allocator), timeBuffer(allocator), spectrum(allocator) {}
 		/// Parameters passed straight to `.resize()`
-		STFT(int channels, int windowSize, int interval, int historyLength=0, int zeroPadding=0) {
+		STFT(int channels, int windowSize, int interval, int historyLength=0, int zeroPadding=0, const Allocator &allocator=Allocator()) : STFT(allocator) {
 			resize(channels, windowSize, interval, historyLength, zeroPadding);
 		}
 
@@ -430,13 +435,13 @@ namespace spectral {
 	/** STFT processing, with input/output.
 		Before calling `.ensureValid(index)`, you should make sure the input is filled up to `index`.
 	*/
-	template<typename Sample>
-	class ProcessSTFT : public STFT<Sample> {
-		using Super = STFT<Sample>;
+	template<typename Sample, class Allocator=std::allocator<Sample>>
+	class ProcessSTFT : public STFT<Sample, Allocator> {
+		using Super = STFT<Sample, Allocator>;
 	public:
-		signalsmith::delay::MultiBuffer<Sample> input;
+		signalsmith::delay::MultiBuffer<Sample, false, signalsmith::delay::StorageNative, Allocator> input;
 	
-		ProcessSTFT(int inChannels, int outChannels, int windowSize, int interval, int historyLength=0) {
+		ProcessSTFT(int inChannels, int outChannels, int windowSize, int interval, int historyLength=0, const Allocator &allocator=Allocator()) : Super(allocator), input(0, 0, allocator) {
 			resize(inChannels, outChannels, windowSize, interval, historyLength);
 		}
 
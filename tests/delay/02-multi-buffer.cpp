@@ -5,10 +5,11 @@
 
 #include "test-delay-stats.h"
 
-TEST("Multi-channel buffer stores data") {
+template<bool interleaved>
+void testMultiBuffer(Test &test) {
 	int delaySize = 100;
 	int channels = 4;
-	using MultiBuffer = signalsmith::delay::MultiBuffer<double>;
+	using MultiBuffer = signalsmith::delay::MultiBuffer<double, interleaved>;
 	MultiBuffer multiBuffer(channels, delaySize);
 	
 	for (int c = 0; c < channels; ++c) {
@@ -119,3 +120,29 @@ TEST("Multi-channel buffer stores data") {
 		TEST_ASSERT(multiBuffer[0][-i] == i);
 	}
 }
+
+TEST("Multi-channel buffer stores data") {
+	testMultiBuffer<false>(test);
+}
+
+TEST("Multi-channel buffer stores data (interleaved)") {
+	testMultiBuffer<true>(test);
+}
+
+TEST("Multi-channel buffer (interleaved) frames are contiguous") {
+	int channels = 5, delaySize = 50;
+	signalsmith::delay::MultiBuffer<double, true> multiBuffer(channels, delaySize);
+
+	for (int r = 0; r < 200; ++r) {
+		++multiBuffer;
+		for (int c = 0; c < channels; ++c) {
+			multiBuffer[c][0] = r + c*0.1;
+		}
+		for (int i = 0; i < delaySize && i <= r; ++i) {
+			const double *frame = multiBuffer.at(-i).data();
+			for (int c = 0; c < channels; ++c) {
+				TEST_ASSERT(frame[c] == (r - i) + c*0.1);
+			}
+		}
+	}
+}
@@ -7,11 +7,12 @@
 #include <iostream>
 #include <array>
 
-TEST("Multi-Delay") {
+template<bool interleaved>
+void testMultiDelay(Test &test) {
 	constexpr int channels = 3;
 	int delayLength = 80;
 	
-	signalsmith::delay::MultiDelay<double> multiDelay(channels, delayLength);
+	signalsmith::delay::MultiDelay<double, signalsmith::delay::InterpolatorLinear, interleaved> multiDelay(channels, delayLength);
 	
 	// Put a known sequence in
 	for (int i = 0; i < delayLength; ++i) {
@@ -31,3 +32,33 @@ TEST("Multi-Delay") {
 		}
 	}
 }
+
+TEST("Multi-Delay") {
+	testMultiDelay<false>(test);
+}
+
+TEST("Multi-Delay (interleaved)") {
+	testMultiDelay<true>(test);
+}
+
+TEST("Multi-Delay layouts match") {
+	constexpr int channels = 6;
+	int delayLength = 100;
+	using Interpolator = signalsmith::delay::InterpolatorCubic<double>;
+	signalsmith::delay::MultiDelay<double, signalsmith::delay::InterpolatorCubic> planar(channels, delayLength);
+	signalsmith::delay::MultiDelay<double, signalsmith::delay::InterpolatorCubic, true> interleaved(channels, delayLength);
+
+	std::array<double, channels> input, delays, outPlanar, outInterleaved;
+	for (int i = 0; i < 1000; ++i) {
+		for (int c = 0; c < channels; ++c) {
+			input[c] = test.random(-1, 1);
+			delays[c] = test.random(Interpolator::inputLength, delayLength);
+		}
+		planar.write(input).readMulti(delays, outPlanar);
+		interleaved.write(input).readMulti(delays, outInterleaved);
+		for (int c = 0; c < channels; ++c) {
+			TEST_ASSERT(outPlanar[c] == outInterleaved[c]);
+			TEST_ASSERT(planar[c].read(delays[c]) == interleaved[c].read(delays[c]));
+		}
+	}
+}
@@ -0,0 +1,95 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "fdn.h"
+
+#include <array>
+#include <vector>
+
+template<int channels, class Matrix>
+void testFdnMatchesReference(Test &test) {
+	using Fdn = signalsmith::delay::FeedbackDelayNetwork<double, channels, Matrix>;
+	
+	std::array<int, channels> delays;
+	for (auto &d : delays) d = test.randomInt(5, 200);
+	Fdn fdn(delays);
+	fdn.setDecay(5000);
+
+	// Reference, wired up by hand one sample at a time
+	signalsmith::delay::MultiDelay<double> multiDelay(channels, 200);
+	std::array<signalsmith::filters::BiquadStatic<double>, channels> filters;
+	signalsmith::mix::StereoMultiMixer<double, channels> mixer;
+	std::array<double, channels> readDelays, gains;
+	for (int c = 0; c < channels; ++c) {
+		double freq = test.random(0.05, 0.45);
+		fdn.filter(c).lowpass(freq);
+		filters[c].lowpass(freq);
+		readDelays[c] = delays[c] - 1; // since we read before writing
+		gains[c] = std::pow(10, -3*delays[c]/5000.0);
+	}
+	
+	int length = 2000;
+	std::vector<std::vector<double>> input(2, std::vector<double>(length)), output = input;
+	for (auto &channel : input) {
+		for (auto &v : channel) v = test.random(-1, 1);
+	}
+	
+	// Random block sizes
+	int start = 0;
+	while (start < length) {
+		int blockLength = std::min(length - start, test.randomInt(0, 500));
+		double *inputPointers[2] = {input[0].data() + start, input[1].data() + start};
+		double *outputPointers[2] = {output[0].data() + start, output[1].data() + start};
+		fdn.process(inputPointers, outputPointers, blockLength);
+		start += blockLength;
+	}
+
+	Matrix matrix;
+	for (int i = 0; i < length; ++i) {
+		std::array<double, channels> line;
+		multiDelay.readMulti(readDelays, line);
+		for (int c = 0; c < channels; ++c) {
+			line[c] = filters[c](line[c])*gains[c];
+		}
+
+		std::array<double, 2> stereo, stereoIn{{input[0][i], input[1][i]}};
+		mixer.multiToStereo(line, stereo);
+		TEST_APPROX(stereo[0]*mixer.scalingFactor2(), output[0][i], 1e-12);
+		TEST_APPROX(stereo[1]*mixer.scalingFactor2(), output[1][i], 1e-12);
+		
+		matrix.inPlace(line);
+		std::array<double, channels> multiIn;
+		mixer.stereoToMulti(stereoIn, multiIn);
+		for (int c = 0; c < channels; ++c) line[c] += multiIn[c];
+		multiDelay.write(line);
+	}
+}
+
+TEST("Feedback delay network matches reference") {
+	using namespace signalsmith::mix;
+	testFdnMatchesReference<2, Householder<double, 2>>(test);
+	testFdnMatchesReference<4, Householder<double, 4>>(test);
+	testFdnMatchesReference<8, Hadamard<double, 8>>(test);
+	testFdnMatchesReference<16, Hadamard<double, 16>>(test);
+	testFdnMatchesReference<6, Householder<double, 6>>(test);
+}
+
+TEST("Feedback delay network is in-place safe") {
+	std::array<int, 4> delays{{23, 47, 61, 89}};
+	signalsmith::delay::FeedbackDelayNetwork<float, 4> fdnA(delays), fdnB(delays);
+	fdnA.setFeedback(0.9);
+	fdnB.setFeedback(0.9);
+	
+	int length = 500;
+	std::vector<std::vector<float>> buffer(2, std::vector<float>(length)), separate = buffer;
+	for (int c = 0; c < 2; ++c) {
+		for (auto &v : buffer[c]) v = test.random(-1, 1);
+	}
+	fdnA.process(buffer, separate, length);
+	fdnB.process(buffer, buffer, length);
+	for (int c = 0; c < 2; ++c) {
+		for (int i = 0; i < length; ++i) {
+			TEST_ASSERT(buffer[c][i] == separate[c][i]);
+		}
+	}
+}
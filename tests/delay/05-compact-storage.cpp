@@ -0,0 +1,100 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "delay.h"
+#include "test-delay-stats.h"
+
+#include <cmath>
+#include <string>
+
+TEST("Float16 conversion") {
+	using Float16 = signalsmith::delay::_storage_impl::Float16;
+	// Every non-NaN half value survives a round-trip
+	for (int i = 0; i < 65536; ++i) {
+		uint16_t half = uint16_t(i);
+		bool isNan = ((half&0x7C00) == 0x7C00) && (half&0x03FF);
+		if (isNan) {
+			TEST_ASSERT(std::isnan(Float16::decode(half)));
+			continue;
+		}
+		TEST_EQUAL(Float16::encode(Float16::decode(half)), half);
+	}
+	TEST_EQUAL(Float16::decode(Float16::encode(0.1f)), 0.0999755859375f);
+	TEST_EQUAL(Float16::decode(Float16::encode(-65504)), -65504);
+	TEST_ASSERT(std::isinf(Float16::decode(Float16::encode(1e6))));
+	// Round to nearest even, halfway between 1 and the next value
+	TEST_EQUAL(Float16::decode(Float16::encode(1 + 1/2048.0f)), 1);
+	TEST_EQUAL(Float16::decode(Float16::encode(1 + 3/2048.0f)), 1 + 2/1024.0f);
+}
+
+TEST("Scaled integer storage") {
+	signalsmith::delay::Buffer<double, signalsmith::delay::StorageInt16> buffer16(10);
+	signalsmith::delay::Buffer<double, signalsmith::delay::StorageInt24> buffer24(10);
+	double values[] = {0, 1, -1, 0.5, -0.25, 2, -3};
+	double expected[] = {0, 1, -1, 0.5, -0.25, 1, -1}; // clipped outside ±1
+	for (int i = 0; i < 7; ++i) {
+		buffer16[i] = values[i];
+		buffer24[i] = values[i];
+	}
+	for (int i = 0; i < 7; ++i) {
+		TEST_APPROX(buffer16[i], expected[i], 0.5/32767);
+		TEST_APPROX(buffer24[i], expected[i], 0.5/8388607);
+	}
+	TEST_EQUAL(sizeof(signalsmith::delay::StorageInt24<float>::Stored), 3);
+	TEST_EQUAL(sizeof(signalsmith::delay::StorageInt16<float>::Stored), 2);
+	TEST_EQUAL(sizeof(signalsmith::delay::StorageFloat16<float>::Stored), 2);
+}
+
+template<template<typename> class Storage>
+void testCompactStats(Test &test, std::string name) {
+	// Impulses are exact in all formats, so these should match the native cubic measurements
+	signalsmith::delay::Delay<double, signalsmith::delay::InterpolatorCubic, Storage> delay;
+	auto result = collectFractionalDelayStats<double>(test, delay, "delay-random-access-cubic-" + name);
+
+	double bandwidth[] = {90, 80, 50, 25, 12.5};
+	double aliasing[] = {-8, -11, -24, -43.5, -62.5};
+	double ampLow[] = {-13, -7, -1.1, -0.08, -0.01};
+	double ampHigh[] = {0.01, 0.01, 0.01, 0.01, 0.01};
+	double delayError[] = {1.5, 0.7, 0.15, 0.04, 0.01};
+	result.test(test, bandwidth, aliasing, ampLow, ampHigh, delayError);
+}
+
+TEST("Delay: compact storage stats") {
+	testCompactStats<signalsmith::delay::StorageFloat16>(test, "float16");
+	testCompactStats<signalsmith::delay::StorageInt16>(test, "int16");
+	testCompactStats<signalsmith::delay::StorageInt24>(test, "int24");
+}
+
+template<template<typename> class Storage>
+double compactNoiseErrorDb(Test &test) {
+	int length = 65536, maxDelay = 1000;
+	signalsmith::delay::Delay<double, signalsmith::delay::InterpolatorCubic> reference(maxDelay);
+	signalsmith::delay::Delay<double, signalsmith::delay::InterpolatorCubic, Storage> compact(maxDelay);
+
+	double signalEnergy = 0, errorEnergy = 0;
+	for (int i = 0; i < length; ++i) {
+		double v = test.random(-1, 1);
+		double delaySamples = test.random(0, maxDelay - 4);
+		double expected = reference.write(v).read(delaySamples);
+		double actual = compact.write(v).read(delaySamples);
+		signalEnergy += expected*expected;
+		errorEnergy += (actual - expected)*(actual - expected);
+	}
+	return 10*std::log10(errorEnergy/signalEnergy + 1e-300);
+}
+
+TEST("Delay: compact storage noise") {
+	double float16 = compactNoiseErrorDb<signalsmith::delay::StorageFloat16>(test);
+	double int16 = compactNoiseErrorDb<signalsmith::delay::StorageInt16>(test);
+	double int24 = compactNoiseErrorDb<signalsmith::delay::StorageInt24>(test);
+	
+	CsvWriter csv("delay-compact-storage");
+	csv.line("storage", "bytes", "error (dB)");
+	csv.line("float16", 2, float16);
+	csv.line("int16", 2, int16);
+	csv.line("int24", 3, int24);
+
+	TEST_ASSERT(float16 < -72);
+	TEST_ASSERT(int16 < -95);
+	TEST_ASSERT(int24 < -143);
+}
@@ -0,0 +1,62 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "delay.h"
+
+#include <vector>
+
+template<template<typename> class Interpolator>
+void testDelayBlock(Test &test, bool integerDelay, double accuracy) {
+	int capacity = 200;
+	signalsmith::delay::Delay<double, Interpolator> blockDelay(capacity), sampleDelay(capacity);
+
+	std::vector<double> input(1000), output(1000), expected(1000);
+	int index = 0;
+	while (index < 10000) {
+		int length = test.randomInt(0, 300);
+		double delaySamples = test.random(0, capacity);
+		if (integerDelay) delaySamples = std::round(delaySamples);
+		for (int i = 0; i < length; ++i) {
+			input[i] = test.random(-1, 1);
+			expected[i] = sampleDelay.write(input[i]).read(delaySamples);
+		}
+		blockDelay.process(input, output, length, delaySamples);
+		for (int i = 0; i < length; ++i) {
+			if (accuracy == 0) {
+				TEST_EQUAL(output[i], expected[i]);
+			} else {
+				TEST_APPROX(output[i], expected[i], accuracy);
+			}
+		}
+		index += length;
+	}
+
+	// In-place, and with the maximum delay
+	for (int r = 0; r < 10; ++r) {
+		int length = test.randomInt(0, 1000);
+		for (int i = 0; i < length; ++i) {
+			input[i] = test.random(-1, 1);
+			expected[i] = sampleDelay.write(input[i]).read(capacity);
+		}
+		blockDelay.process(input.data(), input.data(), length, capacity);
+		for (int i = 0; i < length; ++i) {
+			TEST_APPROX(input[i], expected[i], accuracy + 1e-300);
+		}
+	}
+}
+
+TEST("Delay block processing: integer delays") {
+	testDelayBlock<signalsmith::delay::InterpolatorNearest>(test, true, 0);
+	testDelayBlock<signalsmith::delay::InterpolatorLinear>(test, true, 0);
+	testDelayBlock<signalsmith::delay::InterpolatorCubic>(test, true, 0);
+	// The per-sample Lagrange isn't bit-exact at integer positions
+	testDelayBlock<signalsmith::delay::InterpolatorLagrange7>(test, true, 1e-12);
+}
+
+TEST("Delay block processing: fractional delays") {
+	testDelayBlock<signalsmith::delay::InterpolatorNearest>(test, false, 0);
+	testDelayBlock<signalsmith::delay::InterpolatorLinear>(test, false, 1e-12);
+	testDelayBlock<signalsmith::delay::InterpolatorCubic>(test, false, 1e-12);
+	testDelayBlock<signalsmith::delay::InterpolatorLagrange7>(test, false, 1e-10);
+	testDelayBlock<signalsmith::delay::InterpolatorKaiserSinc8>(test, false, 1e-12);
+}
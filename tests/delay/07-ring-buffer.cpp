@@ -0,0 +1,98 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "delay.h"
+
+#include <vector>
+#include <thread>
+
+TEST("Ring buffer: partial reads/writes") {
+	signalsmith::delay::RingBuffer<float> ring(100);
+	TEST_EQUAL(ring.capacity(), 100);
+	TEST_EQUAL(ring.writeAvailable(), 100);
+	TEST_EQUAL(ring.readAvailable(), 0);
+
+	std::vector<float> input(1000), output(1000);
+	for (size_t i = 0; i < input.size(); ++i) input[i] = i;
+
+	// Only as much as fits
+	TEST_EQUAL(ring.write(input, 150), 100);
+	TEST_EQUAL(ring.writeAvailable(), 0);
+	TEST_EQUAL(ring.write(input, 10), 0);
+	TEST_EQUAL(ring.readAvailable(), 100);
+
+	TEST_EQUAL(ring.read(30, output), 30);
+	for (int i = 0; i < 30; ++i) TEST_EQUAL(output[i], i);
+	TEST_EQUAL(ring.writeAvailable(), 30);
+
+	// Wraps around
+	TEST_EQUAL(ring.write(input.data() + 100, 50), 30);
+	TEST_EQUAL(ring.read(200, output), 100);
+	for (int i = 0; i < 100; ++i) TEST_EQUAL(output[i], 30 + i);
+	TEST_EQUAL(ring.read(10, output), 0);
+
+	ring.reset();
+	TEST_EQUAL(ring.readAvailable(), 0);
+	TEST_EQUAL(ring.writeAvailable(), 100);
+}
+
+template<bool interleaved>
+void testMultiRing(Test &test) {
+	int channels = 3;
+	signalsmith::delay::MultiRingBuffer<double, interleaved> ring(channels, 50);
+	std::vector<std::vector<double>> input(channels, std::vector<double>(64)), output(channels, std::vector<double>(64));
+
+	long writeCount = 0, readCount = 0;
+	while (readCount < 10000) {
+		int writeLength = test.randomInt(0, 64);
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < writeLength; ++i) input[c][i] = (writeCount + i)*channels + c;
+		}
+		int expected = std::min(writeLength, ring.writeAvailable());
+		TEST_EQUAL(ring.write(input, writeLength), expected);
+		writeCount += expected;
+
+		int readLength = test.randomInt(0, 64);
+		expected = std::min<int>(readLength, writeCount - readCount);
+		TEST_EQUAL(ring.read(readLength, output), expected);
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < expected; ++i) TEST_EQUAL(output[c][i], (readCount + i)*channels + c);
+		}
+		readCount += expected;
+	}
+}
+TEST("Multi-channel ring buffer") {
+	testMultiRing<false>(test);
+}
+TEST("Multi-channel ring buffer (interleaved)") {
+	testMultiRing<true>(test);
+}
+
+TEST("Ring buffer: two threads") {
+	signalsmith::delay::RingBuffer<int> ring(257);
+	int total = 2000000;
+
+	std::thread producer([&]() {
+		std::vector<int> block(100);
+		int index = 0;
+		while (index < total) {
+			int length = std::min<int>(1 + index%97, total - index);
+			for (int i = 0; i < length; ++i) block[i] = index + i;
+			index += ring.write(block, length);
+		}
+	});
+
+	std::vector<int> block(100);
+	int index = 0;
+	bool correct = true;
+	while (index < total) {
+		int length = ring.read(1 + index%89, block);
+		for (int i = 0; i < length; ++i) {
+			if (block[i] != index + i) correct = false;
+		}
+		index += length;
+	}
+	producer.join();
+	TEST_ASSERT(correct);
+	TEST_EQUAL(ring.readAvailable(), 0);
+}
@@ -207,6 +207,20 @@ TEST("Peak hold (boundary bug)") {
 	TEST_ASSERT(peakHold.read() == 1);
 }
 
+TEST("Peak hold (power-of-two max length)") {
+	for (int maxLength : {1, 2, 4, 8, 16}) {
+		signalsmith::envelopes::PeakHold<float> peakHold(maxLength);
+		std::vector<float> signal(200);
+		for (int i = 0; i < int(signal.size()); ++i) {
+			signal[i] = test.randomInt(0, 3);
+			float expected = std::numeric_limits<float>::lowest();
+			for (int j = std::max(0, i - maxLength + 1); j <= i; ++j) expected = std::max(expected, signal[j]);
+			float actual = peakHold(signal[i]);
+			TEST_EQUAL(actual, expected);
+		}
+	}
+}
+
 // TODO: test that expanding size re-includes previous values
 
 //TEST("Peak hold (overflow)") {
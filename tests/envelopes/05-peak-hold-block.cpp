@@ -0,0 +1,63 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+
+#include "envelopes.h"
+
+TEST("Peak hold (block)") {
+	int maxLength = 100;
+	signalsmith::envelopes::PeakHold<float> perSample(maxLength), block(maxLength);
+
+	std::vector<float> input(1100), output(1100);
+	for (int repeat = 0; repeat < 200; ++repeat) {
+		// Occasionally change the size (in the same way for both)
+		if (repeat%10 == 0) {
+			int size = test.randomInt(0, maxLength);
+			perSample.set(size);
+			block.set(size);
+		}
+
+		int length = test.randomInt(0, 1000);
+		if (repeat%3 == 0) length = test.randomInt(0, 2*block.size());
+		for (int i = 0; i < length; ++i) {
+			// Plenty of repeated values
+			input[i] = test.randomInt(-50, 50);
+		}
+		block.process(input.data(), output.data(), length);
+		for (int i = 0; i < length; ++i) {
+			TEST_EQUAL(output[i], perSample(input[i]));
+		}
+		TEST_EQUAL(block.size(), perSample.size());
+		TEST_EQUAL(block.read(), perSample.read());
+	}
+
+	// Per-sample use (including pushing/popping unevenly) continues from a block correctly
+	for (int repeat = 0; repeat < 50; ++repeat) {
+		block.set(test.randomInt(1, maxLength));
+		int length = test.randomInt(block.size(), 1000);
+		for (int i = 0; i < length; ++i) input[i] = test.random(-1, 1);
+		block.process(input.data(), output.data(), length);
+
+		int start = length - block.size(), end = length;
+		for (int r = 0; r < 20; ++r) {
+			if (end - start < maxLength && test.random(0, 1) < 0.5) {
+				input[end] = test.random(-1, 1);
+				block.push(input[end]);
+				++end;
+			} else if (end > start) {
+				block.pop();
+				++start;
+			}
+			float expected = std::numeric_limits<float>::lowest();
+			for (int i = start; i < end; ++i) expected = std::max(expected, input[i]);
+			TEST_EQUAL(block.read(), expected);
+		}
+		// Expanding includes older input
+		int newSize = test.randomInt(0, std::min(end, maxLength));
+		block.set(newSize);
+		float expected = std::numeric_limits<float>::lowest();
+		for (int i = end - newSize; i < end; ++i) expected = std::max(expected, input[i]);
+		TEST_EQUAL(block.read(), expected);
+	}
+}
@@ -0,0 +1,109 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+
+#include "envelopes.h"
+
+static constexpr int channels = 3;
+
+// Compares against separate single-channel filters, plus one for the maximum across channels
+template<class Multi, class Single, class SetLength>
+void testMultiPeak(Test &test, int maxLength, SetLength setLength) {
+	Multi multi(maxLength);
+	std::vector<Single> singles(channels + 1, Single(maxLength));
+
+	std::vector<std::vector<float>> input(channels, std::vector<float>(1000)), output = input;
+	std::vector<float> linked(1000), lastOutput(channels);
+	for (int repeat = 0; repeat < 100; ++repeat) {
+		// Changing the length holds the current peaks, so only compare it after a reset
+		if (repeat%10 == 0) {
+			float start = test.randomInt(-50, 50);
+			double length = test.random(1, maxLength);
+			multi.reset(start);
+			setLength(multi, length);
+			for (auto &single : singles) {
+				single.reset(start);
+				setLength(single, length);
+			}
+		}
+
+		int length = test.randomInt(0, 1000);
+		for (auto &channel : input) {
+			// Plenty of repeated values
+			for (int i = 0; i < length; ++i) channel[i] = test.randomInt(-50, 50);
+		}
+		bool linkedOnly = false;
+		if (repeat%3 == 0) {
+			multi.process(input, output, linked, length);
+		} else if (repeat%3 == 1) {
+			multi.processLinked(input, linked, length);
+			linkedOnly = true;
+		} else {
+			for (int i = 0; i < length; ++i) {
+				float frame[channels];
+				for (int c = 0; c < channels; ++c) frame[c] = input[c][i];
+				linked[i] = multi(frame);
+				for (int c = 0; c < channels; ++c) output[c][i] = multi.read(c);
+			}
+		}
+
+		for (int i = 0; i < length; ++i) {
+			float maxInput = std::numeric_limits<float>::lowest();
+			for (int c = 0; c < channels; ++c) {
+				float expected = lastOutput[c] = singles[c](input[c][i]);
+				if (!linkedOnly) TEST_EQUAL(output[c][i], expected);
+				maxInput = std::max(maxInput, input[c][i]);
+			}
+			float expected = singles[channels](maxInput);
+			TEST_EQUAL(linked[i], expected);
+		}
+		if (length > 0) {
+			for (int c = 0; c < channels; ++c) TEST_EQUAL(multi.read(c), lastOutput[c]);
+			TEST_EQUAL(multi.readLinked(), linked[length - 1]);
+		}
+	}
+}
+
+struct SetHoldLength {
+	template<class Filter>
+	void operator()(Filter &filter, double length) const {
+		filter.set(int(length));
+	}
+};
+struct SetDecayLength {
+	template<class Filter>
+	void operator()(Filter &filter, double length) const {
+		filter.set(length);
+	}
+};
+
+TEST("Multi-channel peak hold") {
+	using Multi = signalsmith::envelopes::MultiPeakHold<float, channels>;
+	using Single = signalsmith::envelopes::PeakHold<float>;
+	for (int maxLength : {1, 2, 5, 64, 100}) {
+		testMultiPeak<Multi, Single>(test, maxLength, SetHoldLength());
+	}
+
+	// Changing the length holds the current peak for the new length
+	Multi multi(50);
+	float frame[channels] = {3, 5, 1};
+	multi(frame);
+	for (int c = 0; c < channels; ++c) frame[c] = 0;
+	multi.set(20);
+	for (int i = 0; i < 19; ++i) {
+		float linked = multi(frame);
+		TEST_EQUAL(linked, 5);
+		TEST_EQUAL(multi.read(0), 3);
+	}
+	float linked = multi(frame);
+	TEST_EQUAL(linked, 0);
+}
+
+TEST("Multi-channel peak decay") {
+	using Multi = signalsmith::envelopes::MultiPeakDecayLinear<float, channels>;
+	using Single = signalsmith::envelopes::PeakDecayLinear<float>;
+	for (int maxLength : {1, 2, 5, 64, 100}) {
+		testMultiPeak<Multi, Single>(test, maxLength, SetDecayLength());
+	}
+}
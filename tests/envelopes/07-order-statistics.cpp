@@ -0,0 +1,143 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+#include <algorithm>
+
+#include "envelopes.h"
+
+TEST("Trough hold") {
+	int maxLength = 100;
+	// Mirror image of a peak-hold on the negated signal
+	signalsmith::envelopes::TroughHold<float> troughHold(maxLength);
+	signalsmith::envelopes::PeakHold<float> peakHold(maxLength);
+	TEST_EQUAL(troughHold.read(), std::numeric_limits<float>::max());
+
+	std::vector<float> input(1000), output(1000);
+	for (int repeat = 0; repeat < 100; ++repeat) {
+		if (repeat%10 == 0) {
+			int size = test.randomInt(0, maxLength);
+			troughHold.set(size);
+			peakHold.set(size);
+		}
+		int length = test.randomInt(0, 1000);
+		for (int i = 0; i < length; ++i) input[i] = test.randomInt(-50, 50);
+		if (repeat%2) {
+			troughHold.process(input.data(), output.data(), length);
+			for (int i = 0; i < length; ++i) {
+				float expected = -peakHold(-input[i]);
+				TEST_EQUAL(output[i], expected);
+			}
+		} else {
+			// Unbalanced push/pop
+			for (int i = 0; i < length; ++i) {
+				if (troughHold.size() < maxLength && test.random(0, 1) < 0.5) {
+					troughHold.push(input[i]);
+					peakHold.push(-input[i]);
+				} else {
+					troughHold.pop();
+					peakHold.pop();
+				}
+				float expected = -peakHold.read();
+				TEST_EQUAL(troughHold.read(), expected);
+			}
+		}
+	}
+}
+
+TEST("Peak/trough hold") {
+	int maxLength = 50, length = 1000;
+	signalsmith::envelopes::PeakTroughHold<double> hold(maxLength);
+	hold.set(30);
+	std::vector<double> input(length), peaks(length), troughs(length);
+	for (auto &v : input) v = test.random(-1, 1);
+	hold.process(input.data(), peaks.data(), troughs.data(), length);
+	for (int i = 0; i < length; ++i) {
+		double expectedPeak = input[i], expectedTrough = input[i];
+		for (int j = std::max(0, i - 29); j < i; ++j) {
+			expectedPeak = std::max(expectedPeak, input[j]);
+			expectedTrough = std::min(expectedTrough, input[j]);
+		}
+		TEST_EQUAL(peaks[i], expectedPeak);
+		TEST_EQUAL(troughs[i], expectedTrough);
+	}
+	TEST_EQUAL(hold.readPeak(), peaks.back());
+	TEST_EQUAL(hold.readTrough(), troughs.back());
+}
+
+TEST("Sliding percentile") {
+	int maxLength = 60;
+	signalsmith::envelopes::SlidingPercentile<double> filter(maxLength);
+	TEST_EQUAL(filter.size(), maxLength);
+
+	// Everything which has ever been input, with the current window at the end
+	std::vector<double> history(maxLength, 0);
+	double percentile = 0.5;
+	auto expected = [&]() -> double {
+		std::vector<double> window(history.end() - filter.size(), history.end());
+		std::sort(window.begin(), window.end());
+		double rank = percentile*(window.size() - 1);
+		int index = int(rank);
+		double fraction = rank - index;
+		if (fraction <= 0) return window[index];
+		return window[index] + (window[index + 1] - window[index])*fraction;
+	};
+	auto randomValue = [&]() -> double {
+		// Plenty of repeated values
+		return (test.random(0, 1) < 0.5) ? test.randomInt(-5, 5) : test.random(-5, 5);
+	};
+
+	std::vector<double> input(500), output(500);
+	for (int repeat = 0; repeat < 200; ++repeat) {
+		switch (repeat%4) {
+			case 0:
+				percentile = (repeat%8) ? test.random(0, 1) : test.randomInt(0, 4)*0.25;
+				filter.setPercentile(percentile);
+				TEST_APPROX(filter.read(), expected(), 1e-12);
+				// Shrinking and then expanding again re-includes older values
+				filter.set(test.randomInt(1, maxLength));
+				TEST_APPROX(filter.read(), expected(), 1e-12);
+				break;
+			case 1: {
+				int length = test.randomInt(0, 500);
+				for (int i = 0; i < length; ++i) input[i] = randomValue();
+				filter.process(input.data(), output.data(), length);
+				for (int i = 0; i < length; ++i) {
+					history.push_back(input[i]);
+					TEST_APPROX(output[i], expected(), 1e-12);
+				}
+				break;
+			}
+			case 2:
+				for (int i = 0; i < 100; ++i) {
+					if (filter.size() < maxLength && test.random(0, 1) < 0.5) {
+						double v = randomValue();
+						filter.push(v);
+						history.push_back(v);
+					} else if (filter.size() > 0) {
+						filter.pop();
+					}
+					if (filter.size() > 0) {
+						TEST_APPROX(filter.read(), expected(), 1e-12);
+					}
+				}
+				break;
+			default:
+				if (filter.size() == 0) filter.set(1);
+				for (int i = 0; i < 100; ++i) {
+					double v = randomValue();
+					double result = filter(v);
+					history.push_back(v);
+					TEST_APPROX(result, expected(), 1e-12);
+				}
+		}
+	}
+
+	// Reset fills the history, keeping the size
+	int size = filter.size();
+	filter.reset(2.5);
+	TEST_EQUAL(filter.size(), size);
+	TEST_EQUAL(filter.read(), 2.5);
+	filter.set(maxLength);
+	TEST_EQUAL(filter.read(), 2.5);
+}
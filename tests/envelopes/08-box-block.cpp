@@ -0,0 +1,139 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+#include <cstdint>
+
+#include "envelopes.h"
+
+TEST("Box sum (block)") {
+	for (int maxLength : {0, 1, 7, 100}) {
+		signalsmith::envelopes::BoxSum<float> perSample(maxLength), block(maxLength);
+		std::vector<float> input(500), output(500);
+		for (int repeat = 0; repeat < 50; ++repeat) {
+			int width = test.randomInt(0, maxLength);
+			int length = test.randomInt(0, 500);
+			for (int i = 0; i < length; ++i) input[i] = test.random(-1, 1);
+			if (repeat%2) {
+				block.process(input.data(), output.data(), length, width);
+			} else {
+				output = input;
+				block.process(output.data(), output.data(), length, width);
+			}
+			for (int i = 0; i < length; ++i) {
+				float expected = perSample.readWrite(input[i], width);
+				TEST_EQUAL(output[i], expected);
+			}
+		}
+	}
+}
+
+TEST("Box stack (block)") {
+	int maxSize = 200;
+	signalsmith::envelopes::BoxStackFilter<float> perSample(maxSize, 4), block(maxSize, 4);
+	std::vector<float> input(1000), output(1000);
+	for (int repeat = 0; repeat < 50; ++repeat) {
+		if (repeat%10 == 0) {
+			int size = test.randomInt(1, maxSize*2);
+			perSample.set(size);
+			block.set(size);
+		}
+		int length = test.randomInt(0, 1000);
+		for (int i = 0; i < length; ++i) input[i] = test.random(-1, 1);
+		if (repeat%2) {
+			block.process(input.data(), output.data(), length);
+		} else {
+			output = input;
+			block.process(output.data(), output.data(), length);
+		}
+		for (int i = 0; i < length; ++i) {
+			float expected = perSample(input[i]);
+			TEST_EQUAL(output[i], expected);
+		}
+	}
+}
+
+TEST("Multi-channel box stack") {
+	constexpr int channels = 3;
+	int maxSize = 150;
+	signalsmith::envelopes::MultiBoxStackFilter<double, channels> multi(maxSize, 3);
+	std::vector<signalsmith::envelopes::BoxStackFilter<double>> singles(channels, {maxSize, 3});
+
+	std::vector<std::vector<double>> input(channels, std::vector<double>(1000)), output = input;
+	for (int repeat = 0; repeat < 50; ++repeat) {
+		if (repeat%10 == 0) {
+			int size = test.randomInt(1, maxSize*2);
+			multi.set(size);
+			for (auto &single : singles) single.set(size);
+		}
+		if (repeat == 25) {
+			double fill = test.random(-1, 1);
+			multi.resize(maxSize, {0.2, 0.5, 0.3});
+			multi.reset(fill);
+			for (auto &single : singles) {
+				single.resize(maxSize, {0.2, 0.5, 0.3});
+				single.reset(fill);
+			}
+		}
+		int length = test.randomInt(0, 1000);
+		for (auto &channel : input) {
+			for (int i = 0; i < length; ++i) channel[i] = test.random(-1, 1);
+		}
+		if (repeat%2) {
+			multi.process(input, output, length);
+		} else {
+			for (int i = 0; i < length; ++i) {
+				double inFrame[channels], outFrame[channels];
+				for (int c = 0; c < channels; ++c) inFrame[c] = input[c][i];
+				multi(inFrame, outFrame);
+				for (int c = 0; c < channels; ++c) output[c][i] = outFrame[c];
+			}
+		}
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < length; ++i) {
+				double expected = singles[c](input[c][i]);
+				TEST_EQUAL(output[c][i], expected);
+			}
+		}
+	}
+}
+
+TEST("Box sum (long windows)") {
+	// Positive values (e.g. energy for loudness metering), over a long window
+	int width = 100000, length = 400000;
+	signalsmith::envelopes::BoxSum<float> plain(width);
+	signalsmith::envelopes::BoxSum<float, std::allocator<float>, double> wide(width);
+	signalsmith::envelopes::BoxSum<float, std::allocator<float>, signalsmith::envelopes::CompensatedSum<float>> compensated(width);
+
+	std::vector<float> input(length);
+	for (auto &v : input) v = test.random(0, 1);
+	std::vector<float> plainOutput(length), wideOutput(length), compensatedOutput(length);
+	plain.process(input.data(), plainOutput.data(), length, width);
+	wide.process(input.data(), wideOutput.data(), length, width);
+	compensated.process(input.data(), compensatedOutput.data(), length, width);
+
+	double exact = 0, plainError = 0, wideError = 0, compensatedError = 0;
+	for (int i = 0; i < length; ++i) {
+		exact += input[i];
+		if (i >= width) exact -= input[i - width];
+		plainError = std::max(plainError, std::abs(plainOutput[i] - exact)/exact);
+		wideError = std::max(wideError, std::abs(wideOutput[i] - exact)/exact);
+		compensatedError = std::max(compensatedError, std::abs(compensatedOutput[i] - exact)/exact);
+	}
+	// Only the final rounding to `float`
+	TEST_ASSERT(wideError < 2e-7);
+	TEST_ASSERT(compensatedError < 2e-7);
+	TEST_ASSERT(plainError > compensatedError*10);
+
+	// Integer sums are exact, even past where `double` would round
+	signalsmith::envelopes::BoxSum<int64_t> integer(1000);
+	std::vector<int64_t> intInput(5000);
+	for (auto &v : intInput) v = test.randomInt(0, 1 << 20)*int64_t(1 << 30) + test.randomInt(0, 1 << 30);
+	int64_t intExact = 0;
+	for (int i = 0; i < int(intInput.size()); ++i) {
+		intExact += intInput[i];
+		if (i >= 1000) intExact -= intInput[i - 1000];
+		int64_t result = integer.readWrite(intInput[i], 1000);
+		TEST_EQUAL(result, intExact);
+	}
+}
@@ -0,0 +1,111 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+#include <cmath>
+
+#include "envelopes.h"
+
+TEST("LFO bank (reproducible)") {
+	constexpr int count = 5;
+	signalsmith::envelopes::LfoBank<count> bankA(100), bankB(99);
+	bankA.set(-1, 2, 0.01, 1, 0.5);
+	bankB.set(-1, 2, 0.01, 1, 0.5);
+	// Different parameters in one lane don't affect the others
+	bankA.setLane(3, 0, 1, 0.05);
+	bankB.setLane(4, 0, 1, 0.05);
+
+	// A bank seeded with `s` matches lanes seeded individually with `s + lane`
+	signalsmith::envelopes::LfoBank<count> bankC(0);
+	for (int lane = 0; lane < count; ++lane) bankC.seedLane(lane, 100 + lane);
+	bankC.set(-1, 2, 0.01, 1, 0.5);
+	bankC.setLane(3, 0, 1, 0.05);
+
+	int length = 2000;
+	std::vector<std::vector<float>> outputA(count, std::vector<float>(length)), outputB = outputA, outputC = outputA;
+	// Block sizes don't change the output
+	for (int start = 0; start < length;) {
+		int block = std::min(length - start, test.randomInt(0, 100));
+		std::vector<float *> pointers(count);
+		for (int lane = 0; lane < count; ++lane) pointers[lane] = outputA[lane].data() + start;
+		bankA.process(pointers, block);
+		start += block;
+	}
+	bankB.process(outputB, length);
+	for (int i = 0; i < length; ++i) {
+		float frame[count];
+		bankC.next(frame);
+		for (int lane = 0; lane < count; ++lane) outputC[lane][i] = frame[lane];
+	}
+
+	for (int lane = 0; lane < count; ++lane) {
+		for (int i = 0; i < length; ++i) {
+			TEST_EQUAL(outputA[lane][i], outputC[lane][i]);
+			if (lane > 0) TEST_EQUAL(outputA[lane - 1][i], outputB[lane][i]);
+		}
+	}
+	// Lanes are all different
+	TEST_ASSERT(outputA[0] != outputA[1]);
+	TEST_ASSERT(outputA[1] != outputA[2]);
+}
+
+TEST("LFO bank (matches CubicLfo)") {
+	// Statistics across many lanes, compared with the same number of `CubicLfo`s
+	constexpr int count = 64;
+	int length = 20000;
+	double rate = 0.01;
+	long seed = test.randomInt(0, 1000000);
+
+	struct Stats {
+		double mean = 0, meanSquare = 0;
+		double crossings = 0;
+		float min = 1e10, max = -1e10;
+		int total = 0;
+		float previous = 0;
+
+		void add(float v, bool first) {
+			mean += v;
+			meanSquare += v*v;
+			if (!first && (v >= 0) != (previous >= 0)) ++crossings;
+			min = std::min(min, v);
+			max = std::max(max, v);
+			previous = v;
+			++total;
+		}
+		void finish() {
+			mean /= total;
+			meanSquare /= total;
+			crossings /= total;
+		}
+	};
+
+	for (double depthVariation : {0.0, 0.3, 1.0}) {
+		double rateVariation = (depthVariation > 0) ? test.random(0, 2) : 0;
+		signalsmith::envelopes::LfoBank<count> bank(seed);
+		bank.set(-1, 1, rate, rateVariation, depthVariation);
+		std::vector<std::vector<float>> output(count, std::vector<float>(length));
+		bank.process(output, length);
+
+		Stats bankStats, lfoStats;
+		for (int lane = 0; lane < count; ++lane) {
+			signalsmith::envelopes::CubicLfo lfo(seed + lane);
+			lfo.set(-1, 1, rate, rateVariation, depthVariation);
+			for (int i = 0; i < length; ++i) {
+				bankStats.add(output[lane][i], i == 0);
+				lfoStats.add(lfo.next(), i == 0);
+			}
+		}
+		bankStats.finish();
+		lfoStats.finish();
+
+		TEST_ASSERT(bankStats.min >= -1 && bankStats.max <= 1);
+		TEST_ASSERT(std::abs(bankStats.mean - lfoStats.mean) < 0.02);
+		TEST_ASSERT(std::abs(bankStats.meanSquare - lfoStats.meanSquare) < 0.02);
+		// Crosses zero twice per cycle
+		TEST_ASSERT(std::abs(bankStats.crossings - lfoStats.crossings) < lfoStats.crossings*0.05);
+		if (depthVariation == 0) {
+			double crossingRate = bankStats.crossings/rate;
+			TEST_ASSERT(crossingRate > 1.8 && crossingRate < 2.2);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+#include <cmath>
+
+#include "envelopes.h"
+
+// The separate filters which `DynamicsDetector` combines
+template<typename Sample>
+struct ComposedDetector {
+	double thresholdDb, ratio, kneeDb;
+	signalsmith::envelopes::PeakHold<Sample> hold;
+	signalsmith::envelopes::PeakDecayLinear<Sample> release;
+	signalsmith::envelopes::BoxStackFilter<Sample> smoother;
+
+	ComposedDetector(int lookahead, int holdLength, int releaseLength, double thresholdDb, double ratio, double kneeDb) : thresholdDb(thresholdDb), ratio(ratio), kneeDb(kneeDb), hold(lookahead + 1 + holdLength), release(std::max(releaseLength, 1)), smoother(lookahead + 1, 3) {
+		hold.reset(0);
+		release.reset(0);
+		smoother.reset(0);
+	}
+
+	Sample operator()(Sample level) {
+		double overDb = 20*std::log10(std::max<double>(level, 1e-30)) - thresholdDb;
+		double reductionDb = 0, slope = 1 - 1/ratio;
+		if (overDb >= kneeDb/2) {
+			reductionDb = slope*overDb;
+		} else if (overDb > -kneeDb/2) {
+			reductionDb = slope*(overDb + kneeDb/2)*(overDb + kneeDb/2)/(2*kneeDb);
+		}
+		Sample smoothed = smoother(release(hold(Sample(reductionDb))));
+		return std::pow(10, -smoothed/20);
+	}
+};
+
+TEST("Dynamics detector") {
+	constexpr int channels = 2;
+	for (int repeat = 0; repeat < 10; ++repeat) {
+		int lookahead = test.randomInt(0, 200), hold = test.randomInt(0, 50), release = test.randomInt(0, 2000);
+		double thresholdDb = test.random(-20, 0), kneeDb = (repeat%3) ? test.random(0, 12) : 0;
+		double ratio = (repeat%2) ? test.random(1, 10) : INFINITY;
+
+		signalsmith::envelopes::DynamicsDetector<double, channels> detector(lookahead, hold, release);
+		detector.setCurve(thresholdDb, ratio, kneeDb);
+		TEST_EQUAL(detector.latency(), lookahead);
+		ComposedDetector<double> composed(lookahead, hold, release, thresholdDb, ratio, kneeDb);
+
+		int length = 5000;
+		std::vector<std::vector<double>> input(channels, std::vector<double>(length));
+		for (int i = 0; i < length; ++i) {
+			// Bursts, with some quiet sections
+			double amp = (i/500)%2 ? 0.1 : 3;
+			for (auto &channel : input) channel[i] = test.random(-amp, amp);
+		}
+		std::vector<double> gain(length);
+		for (int start = 0; start < length;) {
+			int block = std::min(length - start, test.randomInt(0, 2500));
+			std::vector<const double *> pointers;
+			for (auto &channel : input) pointers.push_back(channel.data() + start);
+			detector.process(pointers, gain.data() + start, block);
+			start += block;
+		}
+
+		for (int i = 0; i < length; ++i) {
+			double level = std::max(std::abs(input[0][i]), std::abs(input[1][i]));
+			double expected = composed(level);
+			TEST_APPROX(gain[i], expected, 1e-8);
+		}
+	}
+}
+
+TEST("Dynamics detector (look-ahead)") {
+	int lookahead = 64;
+	signalsmith::envelopes::DynamicsDetector<float, 1> limiter(lookahead, 0, 500);
+	limiter.setCurve(-6, INFINITY);
+	limiter.set(lookahead, 0, 500);
+
+	int length = 1000, peakIndex = 300;
+	std::vector<float> input(length, 0.1f), gain(length);
+	input[peakIndex] = 2;
+	float *inputPointer = input.data();
+	limiter.process(&inputPointer, gain, length);
+
+	// Smooth (monotonic) attack, reaching the full reduction when the delayed peak arrives
+	for (int i = 1; i < length; ++i) {
+		if (i <= peakIndex + lookahead) TEST_ASSERT(gain[i] <= gain[i - 1]);
+		if (i >= peakIndex + lookahead + 1) TEST_ASSERT(gain[i] >= gain[i - 1]);
+	}
+	float limited = input[peakIndex]*gain[peakIndex + lookahead];
+	TEST_APPROX(limited, std::pow(10, -6/20.0), 1e-4);
+	// No reduction before the look-ahead window, and fully released afterwards
+	TEST_EQUAL(gain[peakIndex - 1], 1);
+	TEST_EQUAL(gain[peakIndex + lookahead + 500 + lookahead + 2], 1);
+}
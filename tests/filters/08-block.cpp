@@ -0,0 +1,56 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+
+template<typename Sample>
+void testBlock(Test &test) {
+	using Filter = signalsmith::filters::BiquadStatic<Sample>;
+	using Design = signalsmith::filters::BiquadDesign;
+
+	auto testFilter = [&](Filter &perSample, Filter &block, std::string name) {
+		std::vector<Sample> input(256), expected(256), output(256);
+		for (int repeat = 0; repeat < 20; ++repeat) {
+			int length = test.randomInt(0, 256);
+			for (int i = 0; i < length; ++i) {
+				input[i] = test.random(-1, 1);
+				expected[i] = perSample(input[i]);
+			}
+			if (repeat%2) {
+				block.process(input.data(), output.data(), length);
+			} else {
+				output = input;
+				block.process(output.data(), length); // in-place
+			}
+			for (int i = 0; i < length; ++i) {
+				if (output[i] != expected[i]) return test.fail(name + ": block doesn't match per-sample");
+			}
+		}
+	};
+
+	for (auto design : {Design::bilinear, Design::cookbook, Design::oneSided, Design::vicanek}) {
+		for (int r = 0; r < 10; ++r) {
+			double freq = test.random(0.001, 0.49), octaves = test.random(0.1, 4), db = test.random(-24, 24);
+			Filter perSample, block;
+			perSample.lowpass(freq, octaves, design);
+			block.lowpass(freq, octaves, design);
+			testFilter(perSample, block, "lowpass");
+			perSample.peakDb(freq, db, octaves, design);
+			block.peakDb(freq, db, octaves, design);
+			testFilter(perSample, block, "peak"); // also carries state over a coefficient change
+			perSample.highShelfDb(freq, db, octaves, design);
+			block.highShelfDb(freq, db, octaves, design);
+			testFilter(perSample, block, "high shelf");
+			perSample.allpass(freq, octaves, design);
+			block.allpass(freq, octaves, design);
+			testFilter(perSample, block, "allpass");
+		}
+	}
+}
+
+TEST("Block processing matches per-sample") {
+	testBlock<float>(test);
+	testBlock<double>(test);
+}
@@ -0,0 +1,78 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <array>
+
+template<typename Sample, int channels>
+void testBank(Test &test) {
+	using Filter = signalsmith::filters::BiquadStatic<Sample>;
+	signalsmith::filters::BiquadBank<Sample, channels> bank, bankInterleaved;
+	signalsmith::filters::BiquadBank<Sample, channels, true> bankShared;
+	std::array<Filter, channels> filters;
+	Filter shared;
+	std::array<Filter, channels> sharedFilters;
+
+	auto redesign = [&]() {
+		for (int c = 0; c < channels; ++c) {
+			double freq = test.random(0.01, 0.45), db = test.random(-12, 12);
+			switch (c%4) {
+				case 0: filters[c].lowpass(freq); break;
+				case 1: filters[c].peakDb(freq, db); break;
+				case 2: filters[c].highShelfDb(freq, db); break;
+				default: filters[c].notch(freq);
+			}
+			bank.copyFrom(c, filters[c]);
+			bankInterleaved.copyFrom(c, filters[c]);
+		}
+		shared.bandpass(test.random(0.01, 0.45));
+		bankShared.copyFrom(shared);
+		for (auto &f : sharedFilters) f.copyFrom(shared);
+	};
+
+	int length = 100;
+	std::vector<std::vector<Sample>> input(channels, std::vector<Sample>(length)), output = input, outputShared = input;
+	std::vector<Sample> interleaved(length*channels);
+	for (int repeat = 0; repeat < 10; ++repeat) {
+		redesign(); // keeps the state
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < length; ++i) {
+				input[c][i] = interleaved[i*channels + c] = test.random(-1, 1);
+			}
+		}
+		bank.process(input, output, length);
+		bankShared.process(input, outputShared, length);
+		bankInterleaved.processInterleaved(interleaved.data(), length);
+
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < length; ++i) {
+				Sample x = input[c][i];
+				TEST_EQUAL(output[c][i], filters[c](x));
+				TEST_EQUAL(interleaved[i*channels + c], output[c][i]);
+				TEST_EQUAL(outputShared[c][i], sharedFilters[c](x));
+			}
+		}
+	}
+
+	// Single frames, and reset
+	bank.reset();
+	for (auto &f : filters) f.reset();
+	std::array<Sample, channels> frame;
+	for (int i = 0; i < length; ++i) {
+		for (int c = 0; c < channels; ++c) frame[c] = test.random(-1, 1);
+		std::array<Sample, channels> expected;
+		for (int c = 0; c < channels; ++c) expected[c] = filters[c](frame[c]);
+		bank(frame, frame);
+		TEST_ASSERT(frame == expected);
+	}
+}
+
+TEST("Biquad bank matches separate filters") {
+	testBank<float, 1>(test);
+	testBank<float, 2>(test);
+	testBank<double, 3>(test);
+	testBank<float, 8>(test);
+	testBank<double, 64>(test);
+}
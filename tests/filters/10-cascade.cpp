@@ -0,0 +1,130 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+
+using Cascade = signalsmith::filters::BiquadCascade<double>;
+
+TEST("Butterworth cascade") {
+	for (int order = 1; order <= 12; ++order) {
+		double freq = test.random(0.01, 0.4);
+		Cascade lowpass, highpass;
+		lowpass.butterworthLowpass(freq, order);
+		highpass.butterworthHighpass(freq, order);
+		TEST_EQUAL(lowpass.size(), (order + 1)/2);
+
+		TEST_APPROX(lowpass.responseDb(freq), -3.0103, 0.001);
+		TEST_APPROX(highpass.responseDb(freq), -3.0103, 0.001);
+		TEST_APPROX(lowpass.responseDb(1e-6), 0, 0.001);
+		TEST_APPROX(highpass.responseDb(0.5), 0, 0.001);
+		// Power-complementary
+		for (int i = 0; i < 10; ++i) {
+			double f = test.random(0.001, 0.499);
+			double sum = std::norm(lowpass.response(f)) + std::norm(highpass.response(f));
+			TEST_APPROX(sum, 1, 1e-6);
+		}
+		// Monotonic
+		double prevDb = 1;
+		for (double f = 0.001; f < 0.5; f += 0.001) {
+			double db = lowpass.responseDb(f);
+			TEST_ASSERT(db < prevDb + 1e-9);
+			prevDb = db;
+		}
+	}
+}
+
+TEST("Chebyshev cascade") {
+	for (int order = 1; order <= 10; ++order) {
+		double freq = test.random(0.02, 0.3), ripple = test.random(0.1, 3);
+		Cascade lowpass, highpass;
+		lowpass.chebyshevLowpass(freq, order, ripple);
+		highpass.chebyshevHighpass(freq, order, ripple);
+
+		TEST_APPROX(lowpass.responseDb(freq), -ripple, 0.001);
+		TEST_APPROX(highpass.responseDb(freq), -ripple, 0.001);
+		// Ripple stays in range across the passband, and touches both ends
+		double minDb = 0, maxDb = -100;
+		for (int i = 0; i <= 1000; ++i) {
+			double f = freq*i/1000;
+			double db = lowpass.responseDb(std::max(f, 1e-6));
+			minDb = std::min(minDb, db);
+			maxDb = std::max(maxDb, db);
+			db = highpass.responseDb(std::min(freq + (0.5 - freq)*i/1000, 0.5));
+			TEST_ASSERT(db < 0.001 && db > -ripple - 0.001);
+		}
+		TEST_APPROX(maxDb, 0, 0.01);
+		TEST_APPROX(minDb, -ripple, 0.001);
+	}
+}
+
+TEST("Linkwitz-Riley crossover") {
+	for (int order = 2; order <= 16; order += 2) {
+		double freq = test.random(0.01, 0.4);
+		Cascade lowpass, highpass;
+		lowpass.linkwitzRileyLowpass(freq, order);
+		highpass.linkwitzRileyHighpass(freq, order);
+
+		TEST_APPROX(lowpass.responseDb(freq), -6.0206, 0.001);
+		TEST_APPROX(highpass.responseDb(freq), -6.0206, 0.001);
+		// Sum is allpass (with the highpass inverted when order/2 is odd)
+		double polarity = (order%4) ? -1 : 1;
+		for (int i = 0; i < 10; ++i) {
+			double f = test.random(0.001, 0.499);
+			TEST_APPROX(std::abs(lowpass.response(f) + polarity*highpass.response(f)), 1, 1e-6);
+		}
+	}
+}
+
+TEST("Cascade processing") {
+	Cascade perSample, block, parallel;
+	std::vector<double> input(256), expected(256), output(256), outputParallel(256);
+	for (int repeat = 0; repeat < 50; ++repeat) {
+		double freq = test.random(0.01, 0.45);
+		int order = test.randomInt(1, 12);
+		switch (repeat%3) {
+			case 0:
+				perSample.butterworthLowpass(freq, order);
+				break;
+			case 1:
+				perSample.chebyshevHighpass(freq, order, test.random(0.1, 3));
+				break;
+			default:
+				perSample.chebyshevLowpass(freq, order, test.random(0.1, 3), signalsmith::filters::BiquadDesign::vicanek);
+		}
+		block.resize(perSample.size());
+		parallel.resize(perSample.size());
+		for (int s = 0; s < perSample.size(); ++s) {
+			block[s].copyFrom(perSample[s]);
+			parallel[s].copyFrom(perSample[s]);
+		}
+		perSample.reset();
+		block.reset();
+		TEST_ASSERT(parallel.setParallel());
+		TEST_ASSERT(parallel.isParallel());
+
+		int length = test.randomInt(0, 256);
+		for (int i = 0; i < length; ++i) {
+			input[i] = (i == 0) ? 1 : test.random(-1, 1);
+			expected[i] = perSample(input[i]);
+		}
+		if (repeat%2) {
+			block.process(input.data(), output.data(), length);
+			parallel.process(input.data(), outputParallel.data(), length);
+		} else {
+			output = outputParallel = input;
+			block.process(output.data(), length);
+			parallel.process(outputParallel.data(), length);
+		}
+		for (int i = 0; i < length; ++i) {
+			TEST_EQUAL(output[i], expected[i]);
+			TEST_APPROX(outputParallel[i], expected[i], 1e-8);
+		}
+	}
+
+	// Repeated poles can't be expanded
+	parallel.linkwitzRileyLowpass(0.1, 4);
+	TEST_ASSERT(!parallel.setParallel());
+	TEST_ASSERT(!parallel.isParallel());
+}
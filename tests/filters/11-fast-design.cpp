@@ -0,0 +1,68 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <array>
+
+TEST("Fast redesign matches exact designs") {
+	using Filter = signalsmith::filters::BiquadStatic<double>;
+	using Design = signalsmith::filters::BiquadDesign;
+
+	double maxError = 0;
+	auto compare = [&](const Filter &exact, const Filter &fast) {
+		for (int i = 0; i < 20; ++i) {
+			double f = test.random(0, 0.5);
+			std::complex<double> a = exact.response(f), b = fast.response(f);
+			maxError = std::max(maxError, std::abs(a - b)/(std::abs(a) + 1e-3));
+		}
+	};
+
+	for (auto design : {Design::bilinear, Design::cookbook, Design::oneSided, Design::vicanek}) {
+		for (int repeat = 0; repeat < 200; ++repeat) {
+			double freq = test.random(0.001, 0.49), q = test.random(0.3, 10), db = test.random(-24, 24);
+			Filter exact, fast;
+			compare(exact.lowpassQ(freq, q, design), fast.lowpassQFast(freq, q, design));
+			compare(exact.highpassQ(freq, q, design), fast.highpassQFast(freq, q, design));
+			compare(exact.bandpassQ(freq, q, design), fast.bandpassQFast(freq, q, design));
+			compare(exact.notchQ(freq, q, design), fast.notchQFast(freq, q, design));
+			compare(exact.peakDbQ(freq, db, q, design), fast.peakDbQFast(freq, db, q, design));
+			compare(exact.highShelfDbQ(freq, db, q, design), fast.highShelfDbQFast(freq, db, q, design));
+			compare(exact.lowShelfDbQ(freq, db, q, design), fast.lowShelfDbQFast(freq, db, q, design));
+			compare(exact.allpassQ(freq, q, design), fast.allpassQFast(freq, q, design));
+		}
+	}
+	TEST_ASSERT(maxError < 1e-8);
+}
+
+TEST("Fast batch redesign") {
+	constexpr int channels = 6;
+	using Filter = signalsmith::filters::BiquadStatic<float>;
+	signalsmith::filters::BiquadBank<float, channels> bank;
+	std::array<Filter, channels> filters;
+
+	std::vector<double> freqs(channels);
+	std::vector<std::vector<float>> input(channels, std::vector<float>(64)), output = input;
+	for (int repeat = 0; repeat < 20; ++repeat) {
+		double q = test.random(0.5, 4), db = test.random(-12, 12);
+		for (auto &f : freqs) f = test.random(0.001, 0.49);
+		if (repeat%2) {
+			bank.peakDbQFast(freqs, db, q);
+			for (int c = 0; c < channels; ++c) filters[c].peakDbQFast(freqs[c], db, q);
+		} else {
+			bank.lowpassQFast(freqs.data(), q);
+			for (int c = 0; c < channels; ++c) filters[c].lowpassQFast(freqs[c], q);
+		}
+
+		for (int c = 0; c < channels; ++c) {
+			for (auto &v : input[c]) v = test.random(-1, 1);
+		}
+		bank.process(input, output, 64);
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < 64; ++i) {
+				TEST_EQUAL(output[c][i], filters[c](input[c][i]));
+			}
+		}
+	}
+}
@@ -0,0 +1,114 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <array>
+
+TEST("SVF matches biquad responses") {
+	using Biquad = signalsmith::filters::BiquadStatic<double>;
+	using SVF = signalsmith::filters::SVF<double>;
+	using Design = signalsmith::filters::BiquadDesign;
+
+	auto compare = [&](Biquad &biquad, SVF &svf, std::string name) {
+		for (int i = 0; i < 20; ++i) {
+			double f = test.random(0, 0.49);
+			std::complex<double> expected = biquad.response(f);
+			if (std::abs(svf.response(f) - expected) > 1e-6*(std::abs(expected) + 1e-3)) {
+				return test.fail(name + ": response doesn't match");
+			}
+		}
+		// Impulse responses should match as well
+		biquad.reset();
+		svf.reset();
+		for (int i = 0; i < 200; ++i) {
+			double x = (i == 0) ? 1 : 0;
+			double expected = biquad(x), actual = svf(x);
+			if (std::abs(expected - actual) > 1e-6) return test.fail(name + ": impulse doesn't match");
+		}
+	};
+
+	for (auto design : {Design::bilinear, Design::cookbook, Design::oneSided}) {
+		for (int repeat = 0; repeat < 50; ++repeat) {
+			double freq = test.random(0.001, 0.45), q = test.random(0.3, 5), octaves = test.random(0.3, 3), db = test.random(-24, 24);
+			Biquad biquad;
+			SVF svf;
+			compare(biquad.lowpassQ(freq, q, design), svf.lowpassQ(freq, q, design), "lowpassQ");
+			compare(biquad.lowpass(freq, octaves, design), svf.lowpass(freq, octaves, design), "lowpass");
+			compare(biquad.highpassQ(freq, q, design), svf.highpassQ(freq, q, design), "highpassQ");
+			compare(biquad.bandpassQ(freq, q, design), svf.bandpassQ(freq, q, design), "bandpassQ");
+			compare(biquad.bandpass(freq, octaves, design), svf.bandpass(freq, octaves, design), "bandpass");
+			compare(biquad.notchQ(freq, q, design), svf.notchQ(freq, q, design), "notchQ");
+			compare(biquad.peakDbQ(freq, db, q, design), svf.peakDbQ(freq, db, q, design), "peakDbQ");
+			compare(biquad.peakDb(freq, db, octaves, design), svf.peakDb(freq, db, octaves, design), "peakDb");
+			compare(biquad.highShelfDbQ(freq, db, q, design), svf.highShelfDbQ(freq, db, q, design), "highShelfDbQ");
+			compare(biquad.lowShelfDbQ(freq, db, q, design), svf.lowShelfDbQ(freq, db, q, design), "lowShelfDbQ");
+			compare(biquad.lowShelfDb(freq, db, octaves, design), svf.lowShelfDb(freq, db, octaves, design), "lowShelfDb");
+			compare(biquad.allpassQ(freq, q, design), svf.allpassQ(freq, q, design), "allpassQ");
+		}
+	}
+}
+
+TEST("SVF block processing and modulation") {
+	signalsmith::filters::SVF<float> perSample, block;
+	std::vector<float> input(256), expected(256), output(256);
+	for (int repeat = 0; repeat < 20; ++repeat) {
+		perSample.peakDbQ(test.random(0.01, 0.45), test.random(-12, 12), test.random(0.5, 4));
+		block.copyFrom(perSample);
+		int length = test.randomInt(0, 256);
+		for (int i = 0; i < length; ++i) {
+			input[i] = test.random(-1, 1);
+			expected[i] = perSample(input[i]);
+		}
+		block.process(input.data(), output.data(), length);
+		for (int i = 0; i < length; ++i) TEST_EQUAL(output[i], expected[i]);
+	}
+
+	// Jumping to random parameters every sample stays bounded
+	signalsmith::filters::SVF<double> svf;
+	double maxOutput = 0;
+	for (int i = 0; i < 100000; ++i) {
+		svf.lowpassQ(test.random(0.001, 0.49), test.random(0.5, 20));
+		maxOutput = std::max(maxOutput, std::abs(svf(test.random(-1, 1))));
+	}
+	TEST_ASSERT(maxOutput < 100);
+}
+
+TEST("SVF bank") {
+	constexpr int channels = 5;
+	using SVF = signalsmith::filters::SVF<float>;
+	signalsmith::filters::SVFBank<float, channels> bank, bankInterleaved;
+	signalsmith::filters::SVFBank<float, channels, true> bankShared;
+	std::array<SVF, channels> filters, sharedFilters;
+
+	int length = 50;
+	std::vector<std::vector<float>> input(channels, std::vector<float>(length)), output = input, outputShared = input;
+	std::vector<float> interleaved(length*channels);
+	for (int repeat = 0; repeat < 10; ++repeat) {
+		SVF shared;
+		shared.highShelfDbQ(test.random(0.01, 0.45), test.random(-12, 12), 0.7);
+		bankShared.copyFrom(shared);
+		for (int c = 0; c < channels; ++c) {
+			filters[c].bandpassQ(test.random(0.01, 0.45), test.random(0.5, 5));
+			bank.copyFrom(c, filters[c]);
+			bankInterleaved.copyFrom(c, filters[c]);
+			sharedFilters[c].copyFrom(shared);
+			for (int i = 0; i < length; ++i) {
+				input[c][i] = interleaved[i*channels + c] = test.random(-1, 1);
+			}
+		}
+		bank.process(input, output, length);
+		bankShared.process(input, outputShared, length);
+		bankInterleaved.processInterleaved(interleaved.data(), length);
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < length; ++i) {
+				float x = input[c][i];
+				float expected = filters[c](x);
+				TEST_EQUAL(output[c][i], expected);
+				TEST_EQUAL(interleaved[i*channels + c], expected);
+				TEST_EQUAL(outputShared[c][i], sharedFilters[c](x));
+			}
+		}
+	}
+}
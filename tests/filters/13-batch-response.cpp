@@ -0,0 +1,73 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+
+template<typename Sample>
+void testBatchResponse(Test &test, double accuracy) {
+	using Filter = signalsmith::filters::BiquadStatic<Sample>;
+
+	for (int repeat = 0; repeat < 20; ++repeat) {
+		int filterCount = test.randomInt(0, 40);
+		std::vector<Filter> filters(filterCount);
+		for (auto &filter : filters) {
+			double freq = test.random(0.001, 0.49);
+			switch (test.randomInt(0, 3)) {
+				case 0: filter.lowpass(freq); break;
+				case 1: filter.highShelfDb(freq, test.random(-6, 6)); break;
+				case 2: filter.notch(freq); break;
+				default: filter.peakDb(freq, test.random(-6, 6), test.random(0.5, 3));
+			}
+		}
+		// Rounding errors build up through the product, so this scales with the number of filters
+		double tolerance = accuracy*(filterCount + 1);
+		auto expected = [&](Sample f) {
+			std::complex<Sample> result = 1;
+			for (auto &filter : filters) result *= filter.response(f);
+			return result;
+		};
+
+		int count = test.randomInt(1, 1000);
+		std::vector<std::complex<Sample>> output(count);
+		std::vector<Sample> outputDb(count), freqs(count);
+
+		// Linearly-spaced
+		Sample startFreq = test.random(0, 0.1), stepFreq = (0.5 - startFreq)/count;
+		Filter::responsesLinear(filters, filterCount, startFreq, stepFreq, output.data(), count);
+		Filter::responsesDbLinear(filters, filterCount, startFreq, stepFreq, outputDb.data(), count);
+		for (int i = 0; i < count; ++i) {
+			std::complex<Sample> e = expected(startFreq + i*stepFreq);
+			TEST_ASSERT(std::abs(output[i] - e) <= tolerance*(std::abs(e) + 1e-2));
+			Sample db = 10*std::log10(std::norm(e));
+			if (db > -60) TEST_APPROX(outputDb[i], db, accuracy*1e3);
+		}
+
+		// Arbitrary frequencies
+		for (auto &f : freqs) f = test.random(0, 0.5);
+		Filter::responses(filters, filterCount, freqs.data(), output.data(), count);
+		Filter::responsesDb(filters, filterCount, freqs.data(), outputDb.data(), count);
+		for (int i = 0; i < count; ++i) {
+			std::complex<Sample> e = expected(freqs[i]);
+			TEST_ASSERT(std::abs(output[i] - e) <= tolerance*(std::abs(e) + 1e-2));
+			Sample db = 10*std::log10(std::norm(e));
+			if (db > -60) TEST_APPROX(outputDb[i], db, accuracy*1e3);
+		}
+	}
+}
+
+TEST("Batch responses") {
+	testBatchResponse<double>(test, 1e-9);
+	testBatchResponse<float>(test, 1e-3);
+}
+
+TEST("Batch responses for a cascade") {
+	signalsmith::filters::BiquadCascade<double> cascade;
+	cascade.chebyshevLowpass(0.1, 7, 0.5);
+	std::vector<double> db(300);
+	cascade.responsesDbLinear(0.001, 0.001, db.data(), 300);
+	for (int i = 0; i < 300; ++i) {
+		TEST_APPROX(db[i], cascade.responseDb(0.001 + i*0.001), 1e-6);
+	}
+}
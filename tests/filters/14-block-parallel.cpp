@@ -0,0 +1,65 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <thread>
+#include <functional>
+
+TEST("Block-parallel biquad matches serial") {
+	using Filter = signalsmith::filters::BiquadStatic<double>;
+
+	for (int chunkLength : {2, 3, 64, 1000}) {
+		Filter serial;
+		serial.lowpassQ(test.random(0.001, 0.1), test.random(0.5, 10));
+		signalsmith::filters::BiquadBlockParallel<double> blockParallel(chunkLength);
+		blockParallel.copyFrom(serial);
+
+		std::vector<double> input(5000), expected(5000), output(5000);
+		for (int repeat = 0; repeat < 20; ++repeat) {
+			int length = test.randomInt(0, 5000);
+			for (int i = 0; i < length; ++i) {
+				input[i] = test.random(-1, 1);
+				expected[i] = serial(input[i]);
+			}
+			if (repeat%2) {
+				blockParallel.process(input.data(), output.data(), length);
+			} else {
+				// Chunks in reverse order, to check they're independent
+				blockParallel.process(input.data(), output.data(), length, [](int count, std::function<void(int)> task) {
+					for (int i = count - 1; i >= 0; --i) task(i);
+				});
+			}
+			for (int i = 0; i < length; ++i) {
+				TEST_APPROX(output[i], expected[i], 1e-10);
+			}
+		}
+	}
+}
+
+TEST("Block-parallel biquad with threads") {
+	signalsmith::filters::BiquadStatic<float> serial;
+	serial.peakDb(0.05, 12, 0.5);
+	signalsmith::filters::BiquadBlockParallel<float> blockParallel(1000);
+	blockParallel.copyFrom(serial);
+
+	int length = 100000, threadCount = 4;
+	std::vector<float> input(length), expected(length), output(length);
+	for (int i = 0; i < length; ++i) {
+		input[i] = test.random(-1, 1);
+		expected[i] = serial(input[i]);
+	}
+	blockParallel.process(input.data(), output.data(), length, [&](int count, std::function<void(int)> task) {
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&, t]() {
+				for (int i = t; i < count; i += threadCount) task(i);
+			});
+		}
+		for (auto &thread : threads) thread.join();
+	});
+	for (int i = 0; i < length; ++i) {
+		TEST_APPROX(output[i], expected[i], 1e-4);
+	}
+}
@@ -0,0 +1,104 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <array>
+
+TEST("Biquad coefficient ramp") {
+	using Filter = signalsmith::filters::BiquadRamped<double>;
+	// Ramping is opt-in, and doesn't add anything to the plain biquad
+	static_assert(sizeof(signalsmith::filters::BiquadStatic<double>) == 9*sizeof(double), "BiquadStatic should only hold its coefficients and state");
+
+	// Pure gain, so the output shows the ramp directly
+	Filter filter;
+	filter.rampTo(Filter().addGain(0.5), 10);
+	TEST_EQUAL(filter.rampSamples(), 10);
+	for (int i = 0; i < 20; ++i) {
+		double expected = (i < 10) ? 1 - 0.5*(i + 1)/10 : 0.5;
+		TEST_APPROX(filter(1), expected, 1e-12);
+	}
+	TEST_EQUAL(filter.rampSamples(), 0);
+
+	// Block processing matches per-sample, and ends on the exact target
+	Filter perSample, block, target;
+	std::vector<double> input(256), expected(256), output(256);
+	for (int repeat = 0; repeat < 50; ++repeat) {
+		if (repeat%3 == 0) {
+			target.peakDb(test.random(0.01, 0.45), test.random(-12, 12));
+			int rampLength = test.randomInt(0, 300);
+			perSample.rampTo(target, rampLength);
+			block.rampTo(target, rampLength);
+		}
+		int length = test.randomInt(0, 256);
+		for (int i = 0; i < length; ++i) {
+			input[i] = test.random(-1, 1);
+			expected[i] = perSample(input[i]);
+		}
+		block.process(input.data(), output.data(), length);
+		for (int i = 0; i < length; ++i) TEST_EQUAL(output[i], expected[i]);
+		TEST_EQUAL(block.rampSamples(), perSample.rampSamples());
+		if (block.rampSamples() == 0) {
+			TEST_EQUAL(block.response(0.1), target.response(0.1));
+		}
+	}
+
+	// Designing cancels the ramp
+	block.rampTo(target, 100);
+	block.lowpass(0.1);
+	TEST_EQUAL(block.rampSamples(), 0);
+}
+
+TEST("Biquad bank and cascade ramps") {
+	constexpr int channels = 4;
+	using Filter = signalsmith::filters::BiquadRamped<float>;
+	signalsmith::filters::BiquadBank<float, channels, false, true> bank;
+	std::array<Filter, channels> filters, targets;
+
+	int length = 50;
+	std::vector<std::vector<float>> input(channels, std::vector<float>(length)), output = input;
+	for (int repeat = 0; repeat < 20; ++repeat) {
+		int rampLength = test.randomInt(0, 120);
+		if (repeat%2) {
+			for (int c = 0; c < channels; ++c) {
+				targets[c].lowpass(test.random(0.01, 0.45));
+				filters[c].rampTo(targets[c], rampLength);
+			}
+			bank.rampEachTo(targets, rampLength);
+		} else {
+			Filter shared;
+			shared.highShelfDb(test.random(0.01, 0.45), test.random(-12, 12));
+			for (auto &f : filters) f.rampTo(shared, rampLength);
+			bank.rampTo(shared, rampLength);
+		}
+		// One channel is designed directly, which stops its ramp
+		filters[1].lowpass(0.2);
+		bank.copyFrom(1, filters[1]);
+
+		for (int c = 0; c < channels; ++c) {
+			for (auto &v : input[c]) v = test.random(-1, 1);
+		}
+		bank.process(input, output, length);
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < length; ++i) {
+				float expected = filters[c](input[c][i]);
+				TEST_EQUAL(output[c][i], expected);
+			}
+		}
+	}
+
+	signalsmith::filters::BiquadCascade<double, true> cascade, reference;
+	signalsmith::filters::BiquadCascade<double> cascadeTarget;
+	cascade.butterworthLowpass(0.05, 4);
+	reference.butterworthLowpass(0.05, 4);
+	cascadeTarget.butterworthLowpass(0.2, 4);
+	cascade.rampTo(cascadeTarget, 64);
+	for (int s = 0; s < reference.size(); ++s) reference[s].rampTo(cascadeTarget[s], 64);
+	std::vector<double> block(100);
+	for (auto &v : block) v = test.random(-1, 1);
+	std::vector<double> expected = block;
+	for (auto &v : expected) v = reference(v);
+	cascade.process(block.data(), 100);
+	for (int i = 0; i < 100; ++i) TEST_EQUAL(block[i], expected[i]);
+}
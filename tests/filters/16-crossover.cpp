@@ -0,0 +1,113 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "filters.h"
+
+#include <vector>
+#include <algorithm>
+
+using Crossover = signalsmith::filters::Crossover<double>;
+using Cascade = signalsmith::filters::BiquadCascade<double>;
+
+static std::vector<double> randomSplits(Test &test, int splitCount) {
+	std::vector<double> splitFreqs(splitCount);
+	for (auto &f : splitFreqs) f = test.random(0.01, 0.45);
+	std::sort(splitFreqs.begin(), splitFreqs.end());
+	return splitFreqs;
+}
+
+TEST("Crossover responses") {
+	for (int bands = 1; bands <= 9; ++bands) {
+		for (int order : {2, 4, 6, 8}) {
+			auto splitFreqs = randomSplits(test, bands - 1);
+			Crossover crossover;
+			crossover.linkwitzRiley(splitFreqs, bands - 1, order);
+			TEST_EQUAL(crossover.bands(), bands);
+
+			std::vector<Cascade> lowpass(bands - 1), highpass(bands - 1);
+			for (int s = 0; s < bands - 1; ++s) {
+				lowpass[s].linkwitzRileyLowpass(splitFreqs[s], order);
+				highpass[s].linkwitzRileyHighpass(splitFreqs[s], order);
+			}
+
+			for (int r = 0; r < 10; ++r) {
+				double f = test.random(0.001, 0.499);
+				// Sums to an allpass
+				std::complex<double> sum = 0;
+				for (int b = 0; b < bands; ++b) sum += crossover.response(b, f);
+				TEST_APPROX(std::abs(sum), 1, 1e-6);
+
+				// Each band has its own highpass/lowpass.  The other splits are either allpasses, or (depending on the tree) more highpasses below/lowpasses above.
+				for (int b = 0; b < bands; ++b) {
+					double maxDb = 0, minDb = 0;
+					for (int s = 0; s < bands - 1; ++s) {
+						if (s == b - 1) {
+							maxDb += highpass[s].responseDb(f);
+						} else if (s == b) {
+							maxDb += lowpass[s].responseDb(f);
+						} else {
+							minDb += ((s < b) ? highpass[s] : lowpass[s]).responseDb(f);
+						}
+					}
+					minDb += maxDb;
+					double db = crossover.responseDb(b, f);
+					if (minDb > -100) {
+						TEST_ASSERT(db < maxDb + 1e-6);
+						TEST_ASSERT(db > minDb - 1e-6);
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST("Crossover processing") {
+	int channels = 3, bands = 6, length = 2000;
+	auto splitFreqs = randomSplits(test, bands - 1);
+	Crossover crossover(channels);
+	crossover.linkwitzRiley(splitFreqs, bands - 1, 4);
+	TEST_EQUAL(crossover.channels(), channels);
+
+	// Impulse responses match the frequency responses
+	std::vector<std::vector<double>> input(channels, std::vector<double>(length));
+	std::vector<std::vector<std::vector<double>>> output(bands, input), blockOutput(bands, input);
+	for (int c = 0; c < channels; ++c) input[c][0] = c + 1;
+	crossover.process(input, output, length);
+	for (int b = 0; b < bands; ++b) {
+		for (int r = 0; r < 5; ++r) {
+			double f = test.random(0, 0.5);
+			for (int c = 0; c < channels; ++c) {
+				std::complex<double> sum = 0;
+				for (int i = 0; i < length; ++i) {
+					sum += output[b][c][i]*std::polar(1.0, -2*M_PI*f*i);
+				}
+				TEST_APPROX(sum, crossover.response(b, f)*double(c + 1), 1e-6);
+			}
+		}
+	}
+
+	// Uneven blocks match a single one
+	crossover.reset();
+	for (auto &channel : input) {
+		for (auto &v : channel) v = test.random(-1, 1);
+	}
+	crossover.process(input, output, length);
+	crossover.reset();
+	std::vector<std::vector<double *>> blockPointers(bands, std::vector<double *>(channels));
+	std::vector<const double *> inputPointers(channels);
+	int start = 0;
+	while (start < length) {
+		int blockLength = std::min(test.randomInt(0, 200), length - start);
+		for (int c = 0; c < channels; ++c) {
+			inputPointers[c] = input[c].data() + start;
+			for (int b = 0; b < bands; ++b) blockPointers[b][c] = blockOutput[b][c].data() + start;
+		}
+		crossover.process(inputPointers, blockPointers, blockLength);
+		start += blockLength;
+	}
+	for (int b = 0; b < bands; ++b) {
+		for (int c = 0; c < channels; ++c) {
+			for (int i = 0; i < length; ++i) TEST_EQUAL(blockOutput[b][c][i], output[b][c][i]);
+		}
+	}
+}
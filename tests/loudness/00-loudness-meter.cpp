@@ -0,0 +1,131 @@
+#include <test/tests.h>
+#include "../common.h"
+
+#include <vector>
+#include <cmath>
+
+#include "loudness.h"
+
+// Sines at (peak) dBFS levels, in sections
+struct Section {
+	double seconds, db;
+};
+template<class Meter>
+void processSections(Test &test, Meter &meter, int channels, double sampleRate, std::vector<Section> sections, double freq=1000) {
+	std::vector<std::vector<double>> buffer(channels);
+	double phase = 0;
+	for (auto &section : sections) {
+		int length = int(std::round(section.seconds*sampleRate));
+		double amp = std::pow(10, section.db/20);
+		for (auto &channel : buffer) channel.resize(length);
+		for (int i = 0; i < length; ++i) {
+			double v = amp*std::sin(phase);
+			phase += 2*M_PI*freq/sampleRate;
+			for (auto &channel : buffer) channel[i] = v;
+		}
+		// Random block sizes
+		std::vector<const double *> pointers(channels);
+		for (int start = 0; start < length;) {
+			int block = std::min(length - start, test.randomInt(1, 5000));
+			for (int c = 0; c < channels; ++c) pointers[c] = buffer[c].data() + start;
+			meter.process(pointers, block);
+			start += block;
+		}
+	}
+}
+
+TEST("Loudness meter (EBU Tech 3341)") {
+	for (double sampleRate : {44100.0, 48000.0}) {
+		signalsmith::loudness::LoudnessMeter<double> meter(2, sampleRate);
+
+		// Stereo 1kHz sine at -23dBFS
+		processSections(test, meter, 2, sampleRate, {{20, -23}});
+		TEST_APPROX(meter.momentary(), -23, 0.1);
+		TEST_APPROX(meter.shortTerm(), -23, 0.1);
+		TEST_APPROX(meter.integrated(), -23, 0.1);
+
+		// Same at -33dBFS
+		meter.reset();
+		processSections(test, meter, 2, sampleRate, {{20, -33}});
+		TEST_APPROX(meter.integrated(), -33, 0.1);
+
+		// The quiet sections are below the relative gate
+		meter.reset();
+		processSections(test, meter, 2, sampleRate, {{10, -36}, {60, -23}, {10, -36}});
+		TEST_APPROX(meter.integrated(), -23, 0.1);
+
+		// The quietest sections are below the absolute gate
+		meter.reset();
+		processSections(test, meter, 2, sampleRate, {{10, -72}, {10, -36}, {60, -23}, {10, -36}, {10, -72}});
+		TEST_APPROX(meter.integrated(), -23, 0.1);
+
+		// Louder and quieter sections, which all pass the gate
+		meter.reset();
+		processSections(test, meter, 2, sampleRate, {{20, -26}, {20.1, -20}, {20, -26}});
+		TEST_APPROX(meter.integrated(), -23, 0.1);
+	}
+}
+
+TEST("Loudness meter (channel weights)") {
+	double sampleRate = 48000;
+	signalsmith::loudness::LoudnessMeter<double> stereo(2, sampleRate), surround(5, sampleRate), mono(1, sampleRate);
+	surround.setWeight(2, 0); // LFE
+	surround.setWeight(3, 1.41);
+	surround.setWeight(4, 1.41);
+	processSections(test, stereo, 2, sampleRate, {{5, -20}});
+	processSections(test, surround, 5, sampleRate, {{5, -20}});
+	processSections(test, mono, 1, sampleRate, {{5, -20}});
+	// Energy ratio is (1 + 1 + 0 + 1.41 + 1.41)/2
+	TEST_APPROX(surround.momentary() - stereo.momentary(), 10*std::log10(4.82/2), 0.01);
+	TEST_APPROX(stereo.momentary() - mono.momentary(), 10*std::log10(2), 0.01);
+	// 997Hz at 0dBFS (one channel) is -3.01 LUFS
+	mono.reset();
+	processSections(test, mono, 1, sampleRate, {{5, 0}}, 997);
+	TEST_APPROX(mono.momentary(), -3.01, 0.02);
+}
+
+TEST("Loudness meter (histogram gating)") {
+	// Compare against storing every gating block
+	double sampleRate = 8000;
+	int channels = 2, step = 800, length = sampleRate*120;
+	signalsmith::loudness::LoudnessMeter<double> meter(channels, sampleRate);
+	signalsmith::loudness::LoudnessMeter<double> windowMeter(channels, sampleRate);
+
+	std::vector<std::vector<double>> input(channels, std::vector<double>(length));
+	double amp = 0.1;
+	for (int i = 0; i < length; ++i) {
+		if (i%2000 == 0) amp = std::pow(10, test.random(-80, 0)/20);
+		for (auto &channel : input) channel[i] = test.random(-amp, amp);
+	}
+	meter.process(input, length);
+
+	// Momentary loudness at each 100ms step, from a separate meter
+	std::vector<double> blockEnergies;
+	for (int start = 0; start < length; start += step) {
+		std::vector<const double *> pointers;
+		for (auto &channel : input) pointers.push_back(channel.data() + start);
+		windowMeter.process(pointers, step);
+		if (start + step >= step*4) {
+			double lufs = windowMeter.momentary();
+			if (lufs > -70) blockEnergies.push_back(std::pow(10, (lufs + 0.691)/10));
+		}
+	}
+	double sum = 0;
+	for (auto e : blockEnergies) sum += e;
+	double gate = -0.691 + 10*std::log10(sum/blockEnergies.size()) - 10;
+	double gatedSum = 0;
+	int gatedCount = 0;
+	for (auto e : blockEnergies) {
+		if (-0.691 + 10*std::log10(e) > gate) {
+			gatedSum += e;
+			++gatedCount;
+		}
+	}
+	double expected = -0.691 + 10*std::log10(gatedSum/gatedCount);
+	double integrated = meter.integrated();
+	// Only the blocks near the relative gate are approximated
+	TEST_APPROX(integrated, expected, 0.02);
+
+	meter.resetIntegrated();
+	TEST_ASSERT(meter.integrated() == -std::numeric_limits<double>::infinity());
+}
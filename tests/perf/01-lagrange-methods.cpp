@@ -241,6 +241,7 @@ struct PerformanceResults {
 //		add<LagrangeMulAddBasic>("mul/add basic");
 		add<LagrangeMulAddFranck>("Franck");
 		add<LagrangeBarycentric>("barycentric");
+		add<signalsmith::delay::InterpolatorLagrangeFarrowN>("Farrow");
 		add<KaiserSincN>("kaiser-sinc", false);
 
 		CsvWriter csv(csvName);
@@ -256,6 +257,75 @@ struct PerformanceResults {
 	}
 };
 
+/*////// Many reads from the same position //////*/
+
+template<typename Sample, int n, bool farrow>
+static double measureMultiTap(Test &test, int taps) {
+	using Lagrange = signalsmith::delay::InterpolatorLagrangeN<Sample, n>;
+	using Farrow = signalsmith::delay::InterpolatorLagrangeFarrowN<Sample, n>;
+
+	int positions = 1000;
+	std::vector<Sample> buffer(positions + n + 1);
+	for (auto &v : buffer) v = test.random(-10, 10);
+	std::vector<Sample> fractions(taps);
+	for (auto &f : fractions) f = test.random(0, 1);
+	std::vector<Sample> result(positions*taps);
+
+	Lagrange lagrange;
+	Farrow farrowInterpolator;
+	for (int i = 0; i < positions; ++i) {
+		const Sample *data = buffer.data() + i;
+		auto poly = farrowInterpolator.polynomial(data);
+		Sample *batch = result.data();
+		farrowInterpolator.evaluate(poly, fractions, batch, taps);
+		for (int t = 0; t < taps; ++t) {
+			double expected = lagrange.fractional(data, fractions[t]);
+			double actual = farrowInterpolator.evaluate(poly, fractions[t]);
+			if (std::abs(expected - actual) >= 1e-4 || std::abs(expected - batch[t]) >= 1e-4) {
+				test.fail("Farrow doesn't match Lagrange");
+				return 0;
+			}
+		}
+	}
+
+	int trials = 100;
+	Stopwatch stopwatch{false};
+	for (int trial = 0; trial < trials; ++trial) {
+		stopwatch.startLap();
+		for (int i = 0; i < positions; ++i) {
+			const Sample *data = buffer.data() + i;
+			Sample *output = result.data() + i*taps;
+			if (farrow) {
+				auto poly = farrowInterpolator.polynomial(data);
+				farrowInterpolator.evaluate(poly, fractions.data(), output, taps);
+			} else {
+				for (int t = 0; t < taps; ++t) {
+					output[t] = lagrange.fractional(data, fractions[t]);
+				}
+			}
+		}
+		stopwatch.lap();
+	}
+	double lapTime = stopwatch.optimistic();
+	std::cout << "\t" << taps << ":\t" << lapTime << "\n";
+	return lapTime;
+}
+
+template<typename Sample, int n>
+void runMultiTap(Test &test, std::string csvName) {
+	CsvWriter csv(csvName);
+	csv.write("taps", "current", "Farrow");
+	csv.line();
+	for (int taps = 1; taps <= 64; taps *= 2) {
+		if (!test.success) return;
+		std::cout << "taps (Lagrange/Farrow, N = " << n << "):\n";
+		double lagrange = measureMultiTap<Sample, n, false>(test, taps);
+		double farrow = measureMultiTap<Sample, n, true>(test, taps);
+		csv.write(taps, lagrange, farrow);
+		csv.line();
+	}
+}
+
 TEST("Performance: Lagrange interpolation (double)") {
 	PerformanceResults<double> results(test);
 	results.runAll("performance-lagrange-interpolation-double");
@@ -264,3 +334,7 @@ TEST("Performance: Lagrange interpolation (float)") {
 	PerformanceResults<float> results(test);
 	results.runAll("performance-lagrange-interpolation-float");
 }
+TEST("Performance: Lagrange multi-tap reads (float)") {
+	runMultiTap<float, 7>(test, "performance-lagrange-multitap-7-float");
+	runMultiTap<float, 19>(test, "performance-lagrange-multitap-19-float");
+}
@@ -0,0 +1,152 @@
+// from the shared library
+#include <test/tests.h>
+
+#include "../common.h"
+#include "perf.h"
+#include "delay.h"
+#include "envelopes.h"
+#include "spectral.h"
+#include "rates.h"
+
+#include <vector>
+#include <new>
+
+TEST("Arena alignment and exhaustion") {
+	alignas(32) char memory[1000];
+	signalsmith::perf::Arena arena(memory, sizeof(memory), 32);
+	TEST_ASSERT(arena.capacity() == 1000);
+
+	char *start = memory, *end = memory + sizeof(memory);
+	for (int i = 0; i < 10; ++i) {
+		char *block = (char *)arena.allocate(i + 1);
+		TEST_ASSERT(uintptr_t(block)%32 == 0);
+		TEST_ASSERT(block >= start && block + i + 1 <= end);
+	}
+	size_t used = arena.used();
+	TEST_ASSERT(used > 0 && used <= arena.capacity());
+
+	bool threw = false;
+	try {
+		arena.allocate(1000);
+	} catch (const std::bad_alloc &) {
+		threw = true;
+	}
+	TEST_ASSERT(threw);
+	TEST_ASSERT(arena.used() == used); // failed allocation doesn't use anything
+
+	arena.reset();
+	TEST_ASSERT(arena.used() == 0);
+	TEST_ASSERT(arena.allocate(1000) == memory); // fits exactly, since the start is aligned
+}
+
+template<class A, class B>
+bool buffersMatch(A &a, B &&b, int length) {
+	for (int i = 0; i < length; ++i) {
+		if (a[-i] != b[-i]) return false;
+	}
+	return true;
+}
+
+template<class Stft>
+void stftBlock(Stft &stft, std::vector<float> &window, int blockLength) {
+	stft.ensureValid(0, [&](int) {
+		stft.analyse(0, window);
+		stft.analyse(1, window);
+	});
+	stft += blockLength;
+}
+
+TEST("Arena-allocated DSP state") {
+	using Allocator = signalsmith::perf::ArenaAllocator<float>;
+	alignas(64) static char memory[1<<20];
+	signalsmith::perf::Arena arena(memory, sizeof(memory), 64);
+	auto inArena = [&](const void *ptr) {
+		return (const char *)ptr >= memory && (const char *)ptr < memory + sizeof(memory);
+	};
+
+	// Set up every object first
+	signalsmith::delay::Buffer<float> buffer(100);
+	signalsmith::delay::Buffer<float, signalsmith::delay::StorageNative, Allocator> arenaBuffer(100, arena);
+	signalsmith::delay::Buffer<float, signalsmith::delay::StorageInt16, Allocator> arenaBuffer16(100, arena);
+	signalsmith::delay::MultiBuffer<float, false, signalsmith::delay::StorageNative, Allocator> arenaMulti(3, 100, arena);
+	signalsmith::delay::MultiBuffer<float, true, signalsmith::delay::StorageNative, Allocator> arenaInterleaved(3, 100, arena);
+	signalsmith::delay::Delay<float, signalsmith::delay::InterpolatorCubic> delay(50);
+	signalsmith::delay::Delay<float, signalsmith::delay::InterpolatorCubic, signalsmith::delay::StorageNative, Allocator> arenaDelay(50, arena);
+	signalsmith::envelopes::PeakHold<float> peakHold(37);
+	signalsmith::envelopes::PeakHold<float, Allocator> arenaPeakHold(37, arena);
+	signalsmith::envelopes::BoxSum<float> boxSum(40);
+	signalsmith::envelopes::BoxSum<float, Allocator> arenaBoxSum(40, arena);
+	signalsmith::rates::Oversampler2xFIR<float> oversampler(2, 64, 8);
+	signalsmith::rates::Oversampler2xFIR<float, Allocator> arenaOversampler(2, 64, 8, 0.43, arena);
+	signalsmith::spectral::STFT<float> stft(2, 128, 32);
+	signalsmith::spectral::STFT<float, Allocator> arenaStft(2, 128, 32, 0, 0, arena);
+
+	TEST_ASSERT(inArena(&arenaBuffer[0]));
+	TEST_ASSERT(inArena(&arenaMulti[0][0]));
+	TEST_ASSERT(inArena(&arenaInterleaved[2][0]));
+	TEST_ASSERT(inArena(arenaOversampler[1]));
+	TEST_ASSERT(inArena(&arenaStft[1][0]));
+	TEST_ASSERT(inArena(arenaStft.spectrum[1]));
+
+	// Nothing else is allocated while processing
+	size_t used = arena.used();
+	std::vector<float> block(64), upBlock(64), arenaUpBlock(64), stftWindow(128);
+	for (int r = 0; r < 20; ++r) {
+		for (auto &v : block) v = test.random(-1, 1);
+		for (auto &v : stftWindow) v = test.random(-1, 1);
+
+		for (int i = 0; i < 64; ++i) {
+			float v = block[i];
+			++buffer;
+			++arenaBuffer;
+			++arenaBuffer16;
+			buffer[0] = arenaBuffer[0] = v;
+			arenaBuffer16[0] = v;
+			++arenaMulti;
+			++arenaInterleaved;
+			arenaMulti[1][0] = arenaInterleaved[1][0] = v;
+
+			float d = test.random(0, 50);
+			TEST_ASSERT(delay.write(v).read(d) == arenaDelay.write(v).read(d));
+			TEST_ASSERT(peakHold(v) == arenaPeakHold(v));
+			int width = test.randomInt(0, 40);
+			TEST_ASSERT(boxSum.readWrite(v, width) == arenaBoxSum.readWrite(v, width));
+		}
+		TEST_ASSERT(buffersMatch(buffer, arenaBuffer, 100));
+		TEST_ASSERT(buffersMatch(arenaBuffer, arenaMulti[1], 100));
+		TEST_ASSERT(buffersMatch(arenaBuffer, arenaInterleaved[1], 100));
+		for (int i = 0; i < 100; ++i) {
+			TEST_ASSERT(std::abs(arenaBuffer16[-i] - arenaBuffer[-i]) < 1e-4);
+		}
+
+		oversampler.upChannel(1, block, 64);
+		arenaOversampler.upChannel(1, block, 64);
+		for (int i = 0; i < 128; ++i) {
+			TEST_ASSERT(oversampler[1][i] == arenaOversampler[1][i]);
+		}
+		oversampler.downChannel(1, upBlock, 64);
+		arenaOversampler.downChannel(1, arenaUpBlock, 64);
+		TEST_ASSERT(upBlock == arenaUpBlock);
+
+		stftBlock(stft, stftWindow, 64);
+		stftBlock(arenaStft, stftWindow, 64);
+		for (int i = 0; i < 64; ++i) {
+			TEST_ASSERT(stft[1][-i] == arenaStft[1][-i]);
+		}
+	}
+	TEST_ASSERT(arena.used() == used);
+}
+
+TEST("STFT default and allocator constructors") {
+	// Copy-list-initialisation needs a non-explicit default constructor
+	signalsmith::spectral::STFT<float> stft = {};
+	stft.resize(2, 128, 32);
+	TEST_ASSERT(stft.windowSize() == 128);
+
+	alignas(64) static char memory[1<<16];
+	signalsmith::perf::Arena arena(memory, sizeof(memory), 64);
+	signalsmith::spectral::STFT<float, signalsmith::perf::ArenaAllocator<float>> arenaStft(arena);
+	arenaStft.resize(2, 128, 32);
+	TEST_ASSERT(arenaStft.windowSize() == 128);
+	TEST_ASSERT((const char *)&arenaStft[1][0] >= memory && (const char *)&arenaStft[1][0] < memory + sizeof(memory));
+}
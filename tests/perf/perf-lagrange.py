@@ -11,3 +11,12 @@ for type in ["double", "float"]:
 		axes.plot(data[0], data[i], label=columns[i])
 	axes.set(xlabel="order", ylabel="computation time", ylim=[0, None], xlim=[min(data[0]), max(data[0])], xticks=range(int(min(data[0])), int(max(data[0])) + 1, 2));
 	figure.save("performance-lagrange-interpolation-%s.svg"%type)
+
+for n in [7, 19]:
+	columns, data = article.readCsv("performance-lagrange-multitap-%i-float.csv"%n)
+
+	figure, axes = article.medium()
+	for i in range(1, len(columns)):
+		axes.plot(data[0], data[i], label=columns[i])
+	axes.set(xlabel="taps per position", ylabel="computation time", ylim=[0, None], xlim=[min(data[0]), max(data[0])], xscale="log", xticks=data[0], xticklabels=["%i"%t for t in data[0]]);
+	figure.save("performance-lagrange-multitap-%i-float.svg"%n)
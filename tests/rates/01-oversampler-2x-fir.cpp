@@ -111,7 +111,7 @@ TEST("Oversampler2xFIR upsample") {
 			// impulse somewhere in the first half
 			buffer[test.randomInt(0, maxBlock/2)] = 1;
 			
-			oversampler.resize(1, maxBlock, halfLength, passFreq);
+			oversampler.resize(2, maxBlock, halfLength, passFreq); // channel 1 is used below
 			oversampler.reset();
 			oversampler.upChannel(0, buffer, maxBlock);
 			fftUp.fft(oversampler[0], spectrumUp);
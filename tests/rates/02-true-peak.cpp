@@ -0,0 +1,92 @@
+#include "rates.h"
+
+#include <cmath>
+#include <vector>
+
+// from the shared library
+#include <test/tests.h>
+#include "../common.h"
+
+TEST("True-peak sines") {
+	signalsmith::rates::TruePeak<double> truePeak(1);
+	int length = 2000;
+	std::vector<double> input(length);
+	double worstLow = 1, worstHigh = 0;
+	for (int r = 0; r < 100; ++r) {
+		double freq = test.random(0.01, 0.4), phase = test.random(0, 2*M_PI), amp = test.random(0.1, 2);
+		for (int i = 0; i < length; ++i) input[i] = amp*std::sin(2*M_PI*freq*i + phase);
+		truePeak.reset();
+		double *inputPointer = input.data();
+		// Skip the ringing from the sudden start
+		truePeak.process(&inputPointer, 100);
+		truePeak.resetPeaks();
+		inputPointer += 100;
+		truePeak.process(&inputPointer, length - 100);
+		double ratio = truePeak.peak(0)/amp;
+		// The nearest 4x point might be up to 1/8 of a sample away from the true peak
+		double lowest = std::cos(2*M_PI*freq/8);
+		worstLow = std::min(worstLow, ratio/lowest);
+		worstHigh = std::max(worstHigh, ratio);
+	}
+	// Passband ripple within 0.1dB
+	double maxRipple = std::pow(10, 0.1/20);
+	TEST_ASSERT(worstLow > 1/maxRipple);
+	TEST_ASSERT(worstHigh < maxRipple);
+}
+
+TEST("True-peak fs/4 (between samples)") {
+	// fs/4 with a 45-degree phase: every sample is at ±0.707, but the actual peaks are 1
+	signalsmith::rates::TruePeak<float> truePeak(1);
+	std::vector<float> input(1000);
+	for (int i = 0; i < int(input.size()); ++i) input[i] = std::sin(M_PI*0.5*i + M_PI*0.25);
+	float *inputPointer = input.data();
+	truePeak.process(&inputPointer, int(input.size()));
+	TEST_APPROX(truePeak.peak(0), 1, 0.01);
+}
+
+TEST("True-peak blocks") {
+	int channels = 3, length = 1000;
+	signalsmith::rates::TruePeak<float> truePeakA(channels), truePeakB(channels, 8, 0.4);
+	truePeakB.resize(channels);
+	TEST_EQUAL(truePeakA.latency(), 12);
+
+	std::vector<std::vector<float>> input(channels, std::vector<float>(length)), outputA = input, outputB = input;
+	for (auto &channel : input) {
+		for (auto &v : channel) v = test.random(-1, 1);
+	}
+	// All at once
+	truePeakA.process(input, outputA, length);
+	// Random blocks (including peak-only processing, which must keep the same state)
+	std::vector<float> peaks(channels, 0);
+	for (int start = 0; start < length;) {
+		int block = std::min(length - start, test.randomInt(0, 200));
+		std::vector<const float *> inputPointers;
+		std::vector<float *> outputPointers;
+		for (int c = 0; c < channels; ++c) {
+			inputPointers.push_back(input[c].data() + start);
+			outputPointers.push_back(outputB[c].data() + start);
+		}
+		if (test.random(0, 1) < 0.25) {
+			truePeakB.process(inputPointers, block);
+			for (int c = 0; c < channels; ++c) {
+				for (int i = start; i < start + block; ++i) outputB[c][i] = outputA[c][i];
+			}
+		} else {
+			truePeakB.process(inputPointers, outputPointers, block);
+		}
+		start += block;
+	}
+	for (int c = 0; c < channels; ++c) {
+		float maxPeak = 0;
+		for (int i = 0; i < length; ++i) {
+			TEST_EQUAL(outputA[c][i], outputB[c][i]);
+			// Never less than the (delayed) input
+			if (i >= truePeakA.latency()) TEST_ASSERT(outputA[c][i] >= std::abs(input[c][i - truePeakA.latency()]));
+			maxPeak = std::max(maxPeak, outputA[c][i]);
+		}
+		TEST_EQUAL(truePeakA.peak(c), maxPeak);
+		TEST_EQUAL(truePeakB.peak(c), maxPeak);
+	}
+	truePeakA.resetPeaks();
+	TEST_EQUAL(truePeakA.peak(0), 0);
+}